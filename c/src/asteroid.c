@@ -6,6 +6,10 @@
 #define min(a,b) (a < b ? a : b)
 #define max(a,b) (a > b ? a : b)
 
+#ifdef __wasm_simd128__
+static void trail_basis_init(void);
+#endif
+
 static const SDL_Point ASTEROID_SHAPE[22] = {
     {20, -3},  {17, -8},  {19, -12}, {15, -17},  // top right chunk
     {10, -15}, {5, -18},  {0, -20},              // top edge
@@ -34,13 +38,8 @@ static const SDL_Point CRATER_DETAILS[] = {
     {-8, -6},  {-9, -8},  {-8, -10}, {-6, -9},  {-5, -7}
 };
 
-static void generate_asteroid(Asteroid* asteroid, float scale, F22 x, F22 y) {
-    asteroid->x = x;
-    asteroid->y = y;
+static void build_asteroid_shape(Asteroid* asteroid, float scale) {
     asteroid->scale = scale;
-    asteroid->rotation = ((float)rand() / (float)RAND_MAX) * 360.0f;
-    asteroid->rotation_speed = (((float)rand() / (float)RAND_MAX) * -1.0f);
-    asteroid->active = true;
     asteroid->num_points = sizeof(ASTEROID_SHAPE) / sizeof(ASTEROID_SHAPE[0]);
     asteroid->num_crater_points = sizeof(CRATER_DETAILS) / sizeof(CRATER_DETAILS[0]);
 
@@ -57,13 +56,27 @@ static void generate_asteroid(Asteroid* asteroid, float scale, F22 x, F22 y) {
     }
 }
 
-AsteroidSystem asteroid_system_init(void) {
+static void generate_asteroid(Asteroid* asteroid, Rng* rng, float scale, F22 x, F22 y) {
+    asteroid->x = x;
+    asteroid->y = y;
+    asteroid->rotation = rng_float(rng) * 360.0f;
+    asteroid->rotation_speed = (rng_float(rng) * -1.0f);
+    asteroid->active = true;
+    build_asteroid_shape(asteroid, scale);
+}
+
+AsteroidSystem asteroid_system_init(uint64_t seed) {
     AsteroidSystem system;
     memset(&system, 0, sizeof(AsteroidSystem));
+    system.rng = rng_init(seed, RNG_STREAM_ASTEROIDS);
 
     // Copy base shape
     memcpy(system.base_shape, ASTEROID_SHAPE, sizeof(ASTEROID_SHAPE));
 
+    #ifdef __wasm_simd128__
+    trail_basis_init();
+    #endif
+
     // Initialize all asteroids as inactive
     for (int i = 0; i < MAX_ASTEROIDS; i++) {
         system.asteroids[i].active = false;
@@ -74,7 +87,7 @@ AsteroidSystem asteroid_system_init(void) {
 
 static void spawn_asteroid_layer(AsteroidSystem* system, const WaveGenerator* wave, float layer_multiplier) {
     // Randomly decide spawn pattern (0 = above, 1 = below, 2 = both)
-    int spawn_pattern = rand() % 3;
+    int spawn_pattern = rng_range(&system->rng, 3);
 
     if (spawn_pattern == 0 || spawn_pattern == 2) {
         spawn_asteroid(system, wave, true, layer_multiplier);  // spawn above
@@ -103,7 +116,7 @@ static void spawn_asteroid(AsteroidSystem* system, const WaveGenerator* wave, bo
         }
     }
 
-    int x_offset = 10 + rand() % 90;
+    int x_offset = 10 + rng_range(&system->rng, 90);
     int spawn_x = WINDOW_WIDTH + ASTEROID_BASE_SIZE + x_offset;
 
     // Get ghost Y at actual spawn point if it's within our simulated range
@@ -117,17 +130,18 @@ static void spawn_asteroid(AsteroidSystem* system, const WaveGenerator* wave, bo
     }
     // Randomly choose above or below path
     float scale = MIN_ASTEROID_SCALE +
-                 ((float)rand() / (float)RAND_MAX) * (MAX_ASTEROID_SCALE - MIN_ASTEROID_SCALE);
+                 rng_float(&system->rng) * (MAX_ASTEROID_SCALE - MIN_ASTEROID_SCALE);
 
     // Calculate min and max offset distances
     float min_offset = (ASTEROID_SPAWN_BUFFER + ASTEROID_BASE_SIZE * scale) * layer_multiplier;
     float max_offset = (WINDOW_HEIGHT / 2) * layer_multiplier;
-    float y_offset = min_offset + ((float)rand() / (float)RAND_MAX) * (max_offset - min_offset);
+    float y_offset = min_offset + rng_float(&system->rng) * (max_offset - min_offset);
     int direction = spawn_above ? -1 : 1;
     y_offset *= direction;
 
     generate_asteroid(
         asteroid,
+        &system->rng,
         scale,
         f22_from_float(spawn_x),
         f22_from_float(ghost_y + y_offset)
@@ -160,8 +174,8 @@ void asteroid_system_update(AsteroidSystem* system, const WaveGenerator* wave) {
         int num_layers = 0;//rand() % 3;  // 0 = none, 1 = one layer, 2 = two layers
 
         while (num_layers <= 3) {
-            bool spawn_above = (rand() % 3) >= 1;  // 50% chance for above
-            bool spawn_below = (rand() % 3) >= 1;  // 50% chance for below
+            bool spawn_above = rng_range(&system->rng, 3) >= 1;  // 50% chance for above
+            bool spawn_below = rng_range(&system->rng, 3) >= 1;  // 50% chance for below
             if (spawn_above) spawn_asteroid(system, wave, true, num_layers == 0 ? 1.0f: num_layers * 2.0f);
             if (spawn_below) spawn_asteroid(system, wave, false, num_layers == 0 ? 1.0f: num_layers * 2.0f);
             num_layers++;
@@ -174,16 +188,180 @@ static inline uint8_t lerp(uint8_t a, uint8_t b, float t) {
     return (uint8_t)(a + t * (b - a));
 }
 
-void asteroid_system_render(const AsteroidSystem* system, SDL_Renderer* renderer, F22 camera_y_offset, const Player* player) {
-    static uint32_t animation_timer = 0;
-    animation_timer++;
+#define TRAIL_WAVE_FREQUENCY 5.8f
+
+static inline float trail_t(int j) {
+    return j / (float)(ASTEROID_TRAIL_POINTS - 1);
+}
+
+// The wake segments just behind and in front of the asteroid are boosted
+static inline bool trail_in_wake(float phi) {
+    return (phi > 2.8f && phi < 3.5f) || (phi < 0.7f);
+}
+
+// Index after j when only every step'th trail point is used; the last
+// point is always kept so the trail ends in the same place
+static inline int trail_next(int j, int step) {
+    int next = j + step;
+    if (j < ASTEROID_TRAIL_POINTS - 1 && next > ASTEROID_TRAIL_POINTS - 1) return ASTEROID_TRAIL_POINTS - 1;
+    return next;
+}
+
+static SDL_Color trail_color(int j, float color_factor) {
+    float t = trail_t(j);
+    float phi = t * 2.0f * M_PI;
+
+    uint8_t alpha = (uint8_t)(180.0f * (1.0f - powf(t, 0.5f)));
+    if (trail_in_wake(phi)) {
+        alpha = (uint8_t)min(255, alpha * 1.5f);
+    }
+
+    // Blend trail color based on both distance and trail position
+    float trail_fade = 1.0f - t;  // fade along trail
+    float blend_factor = color_factor * trail_fade;
+
+    // Reddish-orange color scheme
+    uint8_t r = blend_factor > 0.001f ? lerp(150, 180, blend_factor) : 200;
+    uint8_t g = blend_factor > 0.001f ? lerp(150, 50, blend_factor) : 200;
+    uint8_t b = blend_factor > 0.001f ? lerp(150, 255, blend_factor) : 200;
+
+    // Violet color scheme (uncomment to use)
+    // uint8_t r = blend_factor > 0.001f ? lerp(150, 180, blend_factor) : 150;
+    // uint8_t g = blend_factor > 0.001f ? lerp(150, 20, blend_factor) : 150;
+    // uint8_t b = blend_factor > 0.001f ? lerp(150, 255, blend_factor) : 150;
+
+    return (SDL_Color){
+        r, g, b,
+        blend_factor > 0.001f ? max(255, 255 - 0.1f * alpha) : max(0, 255 - alpha * 2)
+    };
+}
+
+static void build_trail(AsteroidMesh* mesh, ScreenPos asteroid_pos, float radius, float scale, float time, int step) {
+    float base_amplitude = radius * 0.2f;
+
+    for (int j = 0; j < ASTEROID_TRAIL_POINTS; j = trail_next(j, step)) {
+        float t = trail_t(j);
+        float phi = t * 2.0f * M_PI;
+
+        float path_x = cosf(phi) * radius * 0.9f;
+        float path_y = sinf(phi) * radius * 0.7f;
+
+        // Enhanced wake segments
+        float wake_boost = trail_in_wake(phi) ? radius * 0.4f : 0;
+
+        float wave_amp = base_amplitude * (1.0f + sinf(phi + M_PI)) + wake_boost;
+        float wave_phase = -time + t * 8.0f;
+        float displacement = wave_amp * sinf(wave_phase * TRAIL_WAVE_FREQUENCY);
+
+        float tangent_x = -sinf(phi);
+        float tangent_y = cosf(phi);
+        float norm = sqrtf(tangent_x * tangent_x + tangent_y * tangent_y);
+        tangent_x /= norm;
+        tangent_y /= norm;
+
+        float stretch = 1.0f + powf(sinf(phi * 0.5f), 2) * 1.2f;
+
+        mesh->trail[j].x = asteroid_pos.x + (path_x * stretch + displacement * tangent_x) + 10 * scale;
+        mesh->trail[j].y = asteroid_pos.y + (path_y * stretch + displacement * tangent_y);
+    }
+}
+
+#ifdef __wasm_simd128__
+// Everything in a trail point except the travelling wave depends only on its
+// index, so the SIMD build tabulates it once, in units of the radius
+typedef struct {
+    float path_x[ASTEROID_TRAIL_POINTS];      // stretched ellipse
+    float path_y[ASTEROID_TRAIL_POINTS];
+    float amplitude[ASTEROID_TRAIL_POINTS];   // wave amplitude with the wake boost
+    float tangent_x[ASTEROID_TRAIL_POINTS];
+    float tangent_y[ASTEROID_TRAIL_POINTS];
+} TrailBasis;
+
+static TrailBasis g_trail_basis;
+
+static void trail_basis_init(void) {
+    for (int j = 0; j < ASTEROID_TRAIL_POINTS; j++) {
+        float phi = trail_t(j) * 2.0f * M_PI;
+        float stretch = 1.0f + powf(sinf(phi * 0.5f), 2) * 1.2f;
+        g_trail_basis.path_x[j] = cosf(phi) * 0.9f * stretch;
+        g_trail_basis.path_y[j] = sinf(phi) * 0.7f * stretch;
+        g_trail_basis.amplitude[j] = 0.2f * (1.0f + sinf(phi + M_PI)) + (trail_in_wake(phi) ? 0.4f : 0.0f);
+        g_trail_basis.tangent_x[j] = -sinf(phi);
+        g_trail_basis.tangent_y[j] = cosf(phi);
+    }
+}
+
+// Four points per iteration. The wave phase advances by a fixed angle per
+// point, so its sine comes from rotating the first four lanes; points can
+// differ from build_trail by a pixel.
+static void build_trail_x4(AsteroidMesh* mesh, ScreenPos asteroid_pos, float radius, float scale, float time) {
+    _Static_assert(ASTEROID_TRAIL_POINTS % 4 == 0, "trail is processed four points at a time");
+    const TrailBasis* basis = &g_trail_basis;
+
+    float sin_lane[4], cos_lane[4];
+    for (int lane = 0; lane < 4; lane++) {
+        float wave_phase = (-time + trail_t(lane) * 8.0f) * TRAIL_WAVE_FREQUENCY;
+        sin_lane[lane] = sinf(wave_phase);
+        cos_lane[lane] = cosf(wave_phase);
+    }
+    float step = 4.0f / (ASTEROID_TRAIL_POINTS - 1) * 8.0f * TRAIL_WAVE_FREQUENCY;
+    v128_t sin_wave = wasm_v128_load(sin_lane);
+    v128_t cos_wave = wasm_v128_load(cos_lane);
+    v128_t sin_step = wasm_f32x4_splat(sinf(step));
+    v128_t cos_step = wasm_f32x4_splat(cosf(step));
+
+    v128_t r = wasm_f32x4_splat(radius);
+    v128_t origin_x = wasm_f32x4_splat(asteroid_pos.x + 10 * scale);
+    v128_t origin_y = wasm_f32x4_splat((float)asteroid_pos.y);
+
+    for (int j = 0; j < ASTEROID_TRAIL_POINTS; j += 4) {
+        v128_t displacement = wasm_f32x4_mul(wasm_f32x4_mul(r, wasm_v128_load(&basis->amplitude[j])), sin_wave);
+        v128_t x = wasm_f32x4_add(wasm_f32x4_mul(r, wasm_v128_load(&basis->path_x[j])),
+                                  wasm_f32x4_mul(displacement, wasm_v128_load(&basis->tangent_x[j])));
+        v128_t y = wasm_f32x4_add(wasm_f32x4_mul(r, wasm_v128_load(&basis->path_y[j])),
+                                  wasm_f32x4_mul(displacement, wasm_v128_load(&basis->tangent_y[j])));
+        x = wasm_i32x4_trunc_sat_f32x4(wasm_f32x4_add(origin_x, x));
+        y = wasm_i32x4_trunc_sat_f32x4(wasm_f32x4_add(origin_y, y));
+
+        wasm_v128_store(&mesh->trail[j], wasm_i32x4_shuffle(x, y, 0, 4, 1, 5));
+        wasm_v128_store(&mesh->trail[j + 2], wasm_i32x4_shuffle(x, y, 2, 6, 3, 7));
+
+        v128_t next_sin = wasm_f32x4_add(wasm_f32x4_mul(sin_wave, cos_step), wasm_f32x4_mul(cos_wave, sin_step));
+        cos_wave = wasm_f32x4_sub(wasm_f32x4_mul(cos_wave, cos_step), wasm_f32x4_mul(sin_wave, sin_step));
+        sin_wave = next_sin;
+    }
+}
+#endif
+
+#define ASTEROID_GRAIN 2  // asteroids per job; each one is ~100 trail points of trig
+
+typedef struct {
+    const AsteroidSystem* system;
+    const Player* player;
+    F22 camera_y_offset;
+    float time;
+    int trail_step;
+    AsteroidMesh* meshes;
+} AsteroidPrepareJob;
+
+static void prepare_asteroid_range(void* arg, int begin, int end) {
+    AsteroidPrepareJob* job = (AsteroidPrepareJob*)arg;
+    const AsteroidSystem* system = job->system;
+    F22 camera_y_offset = job->camera_y_offset;
     
     // Constants for color effect radius
     const float COLOR_RADIUS = 200.0f;
     const float FADE_START = 150.0f;
+
+    ScreenPos player_pos = world_to_screen(
+        job->player->position.x,
+        job->player->position.y,
+        camera_y_offset
+    );
     
-    for (int i = 0; i < MAX_ASTEROIDS; i++) {
+    for (int i = begin; i < end; i++) {
         if (!system->asteroids[i].active) continue;
+        AsteroidMesh* mesh = &job->meshes[i];
 
         float angle = system->asteroids[i].rotation * M_PI / 180.0f;
         float cos_a = cosf(angle);
@@ -196,11 +374,13 @@ void asteroid_system_render(const AsteroidSystem* system, SDL_Renderer* renderer
             system->asteroids[i].y, 
             camera_y_offset
         );
-        ScreenPos player_pos = world_to_screen(
-            player->position.x,
-            player->position.y,
-            camera_y_offset
-        );
+
+        // Layered spawns can sit several screens away; the trail is offset
+        // 10 * scale to the right and reaches ASTEROID_TRAIL_EXTENT radii
+        float trail_shift = 10 * system->asteroids[i].scale;
+        mesh->visible = cull_circle_visible(asteroid_pos.x + trail_shift, asteroid_pos.y,
+                                            radius * ASTEROID_TRAIL_EXTENT + trail_shift);
+        if (!mesh->visible) continue;
 
         float dx = asteroid_pos.x - player_pos.x;
         float dy = asteroid_pos.y - player_pos.y;
@@ -213,102 +393,89 @@ void asteroid_system_render(const AsteroidSystem* system, SDL_Renderer* renderer
         }
         
         // Create the continuous trail
-        const int TRAIL_POINTS = 100;
-        SDL_Point trail[TRAIL_POINTS];
-        
-        float time = animation_timer * 0.025f;
-        float base_amplitude = radius * 0.2f;
-        float wave_frequency = 5.8f;
-        
-        for(int j = 0; j < TRAIL_POINTS; j++) {
-            float t = j / (float)(TRAIL_POINTS - 1);
-            float phi = t * 2.0f * M_PI;
-            
-            float path_x = cosf(phi) * radius * 0.9f;  
-            float path_y = sinf(phi) * radius * 0.7f;
-            
-            // Enhanced wake segments
-            float wake_boost = 0;
-            if (phi > 2.8f && phi < 3.5f) {
-                wake_boost = radius * 0.4f;
-            } else if (phi < 0.7f) {
-                wake_boost = radius * 0.4f;
-            }
-            
-            float wave_amp = base_amplitude * (1.0f + sinf(phi + M_PI)) + wake_boost;
-            float wave_phase = -time + t * 8.0f;
-            float displacement = wave_amp * sinf(wave_phase * wave_frequency);
-            
-            float tangent_x = -sinf(phi);
-            float tangent_y = cosf(phi);
-            float norm = sqrtf(tangent_x * tangent_x + tangent_y * tangent_y);
-            tangent_x /= norm;
-            tangent_y /= norm;
-            
-            float stretch = 1.0f + powf(sinf(phi * 0.5f), 2) * 1.2f;
-            
-            trail[j].x = asteroid_pos.x + (path_x * stretch + displacement * tangent_x) + 10 * system->asteroids[i].scale;
-            trail[j].y = asteroid_pos.y + (path_y * stretch + displacement * tangent_y);
-
-            if (j > 0) {
-                uint8_t alpha = (uint8_t)(180.0f * (1.0f - powf(t, 0.5f)));
-                if ((phi > 2.8f && phi < 3.5f) || (phi < 0.7f)) {
-                    alpha = (uint8_t)min(255, alpha * 1.5f);
-                }
-
-                // Blend trail color based on both distance and trail position
-                float trail_fade = 1.0f - t;  // fade along trail
-                float blend_factor = color_factor * trail_fade;
-
-                // Reddish-orange color scheme
-                uint8_t r = blend_factor > 0.001f ? lerp(150, 180, blend_factor) : 200;
-                uint8_t g = blend_factor > 0.001f ? lerp(150, 50, blend_factor) : 200;
-                uint8_t b = blend_factor > 0.001f ? lerp(150, 255, blend_factor) : 200;
-                
-                // Violet color scheme (uncomment to use)
-                // uint8_t r = blend_factor > 0.001f ? lerp(150, 180, blend_factor) : 150;
-                // uint8_t g = blend_factor > 0.001f ? lerp(150, 20, blend_factor) : 150;
-                // uint8_t b = blend_factor > 0.001f ? lerp(150, 255, blend_factor) : 150;
-                
-                
-                SDL_SetRenderDrawColor(renderer, r, g, b, blend_factor > 0.001f ? max(255, 255 - 0.1f * alpha) : max(0, 255 - alpha * 2));
-                SDL_RenderDrawLine(renderer, 
-                    trail[j-1].x, trail[j-1].y,
-                    trail[j].x, trail[j].y);
-            }
+        #ifdef __wasm_simd128__
+        if (job->trail_step == 1) {
+            build_trail_x4(mesh, asteroid_pos, radius, system->asteroids[i].scale, job->time);
+        } else
+        #endif
+        build_trail(mesh, asteroid_pos, radius, system->asteroids[i].scale, job->time, job->trail_step);
+        for (int j = trail_next(0, job->trail_step); j < ASTEROID_TRAIL_POINTS; j = trail_next(j, job->trail_step)) {
+            mesh->trail_colors[j] = trail_color(j, color_factor);
         }
 
-        // Draw main asteroid shape in white
-        SDL_Point transformed_outline[32];
-        for (int j = 0; j < system->asteroids[i].num_points; j++) {
+        // Main asteroid shape
+        mesh->num_points = system->asteroids[i].num_points;
+        for (int j = 0; j < mesh->num_points; j++) {
             float px = system->asteroids[i].points[j].x;
             float py = system->asteroids[i].points[j].y;
-            transformed_outline[j].x = asteroid_pos.x + (int)(px * cos_a - py * sin_a);
-            transformed_outline[j].y = asteroid_pos.y + (int)(px * sin_a + py * cos_a);
+            mesh->outline[j].x = asteroid_pos.x + (int)(px * cos_a - py * sin_a);
+            mesh->outline[j].y = asteroid_pos.y + (int)(px * sin_a + py * cos_a);
         }
 
+        // Crater details, five points per crater
+        mesh->num_crater_points = system->asteroids[i].num_crater_points;
+        for (int j = 0; j < mesh->num_crater_points; j++) {
+            float px = system->asteroids[i].craters[j].x;
+            float py = system->asteroids[i].craters[j].y;
+            mesh->craters[j].x = asteroid_pos.x + (int)(px * cos_a - py * sin_a);
+            mesh->craters[j].y = asteroid_pos.y + (int)(px * sin_a + py * cos_a);
+        }
+    }
+}
+
+void asteroid_system_prepare(const AsteroidSystem* system, JobSystem* jobs, F22 camera_y_offset, const Player* player, int trail_step, AsteroidMesh* meshes) {
+    static uint32_t animation_timer = 0;
+    animation_timer++;
+
+    AsteroidPrepareJob job = {
+        .system = system,
+        .player = player,
+        .camera_y_offset = camera_y_offset,
+        .time = animation_timer * 0.025f,
+        .trail_step = trail_step < 1 ? 1 : trail_step,
+        .meshes = meshes
+    };
+    jobs_parallel_for(jobs, MAX_ASTEROIDS, ASTEROID_GRAIN, prepare_asteroid_range, &job);
+}
+
+void asteroid_system_render(const AsteroidSystem* system, const Canvas* canvas, JobSystem* jobs, F22 camera_y_offset, const Player* player, int trail_step, CullStats* stats) {
+    static AsteroidMesh meshes[MAX_ASTEROIDS];
+    if (trail_step < 1) trail_step = 1;
+    asteroid_system_prepare(system, jobs, camera_y_offset, player, trail_step, meshes);
+
+    // Drawing calls stay on this thread
+    for (int i = 0; i < MAX_ASTEROIDS; i++) {
+        if (!system->asteroids[i].active) continue;
+        AsteroidMesh* mesh = &meshes[i];
+        cull_count(&stats->asteroids, mesh->visible);
+        if (!mesh->visible) continue;
+
+        int prev = 0;
+        for (int j = trail_next(0, trail_step); j < ASTEROID_TRAIL_POINTS; j = trail_next(j, trail_step)) {
+            SDL_Color c = mesh->trail_colors[j];
+            canvas_color(canvas, c.r, c.g, c.b, c.a);
+            canvas_line(canvas, 
+                mesh->trail[prev].x, mesh->trail[prev].y,
+                mesh->trail[j].x, mesh->trail[j].y);
+            prev = j;
+        }
+
+        // Draw main asteroid shape
         // SDL_SetRenderDrawColor(renderer, 250, 250, 250, 255); // Dark gray fill
-        SDL_SetRenderDrawColor(renderer, 92,72,112, 255); // Dark gray fill
-        fill_polygon(renderer, transformed_outline, system->asteroids[i].num_points);
+        canvas_color(canvas, 92,72,112, 255); // Dark gray fill
+        fill_polygon(canvas, mesh->outline, mesh->num_points);
 
-        SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
-        SDL_RenderDrawLines(renderer, transformed_outline, system->asteroids[i].num_points);
-        SDL_RenderDrawLine(renderer,
-            transformed_outline[system->asteroids[i].num_points-1].x,
-            transformed_outline[system->asteroids[i].num_points-1].y,
-            transformed_outline[0].x,
-            transformed_outline[0].y);
+        canvas_color(canvas, 0, 0, 0, 255);
+        canvas_lines(canvas, mesh->outline, mesh->num_points);
+        canvas_line(canvas,
+            mesh->outline[mesh->num_points-1].x,
+            mesh->outline[mesh->num_points-1].y,
+            mesh->outline[0].x,
+            mesh->outline[0].y);
 
         // Draw crater details
-        for (int j = 0; j < system->asteroids[i].num_crater_points; j += 5) {
-            SDL_Point crater[5];
-            for (int k = 0; k < 5; k++) {
-                float px = system->asteroids[i].craters[j + k].x;
-                float py = system->asteroids[i].craters[j + k].y;
-                crater[k].x = asteroid_pos.x + (int)(px * cos_a - py * sin_a);
-                crater[k].y = asteroid_pos.y + (int)(px * sin_a + py * cos_a);
-            }
-            SDL_RenderDrawLines(renderer, crater, 5);
+        for (int j = 0; j < mesh->num_crater_points; j += 5) {
+            canvas_lines(canvas, &mesh->craters[j], 5);
         }
     }
 }
@@ -439,3 +606,40 @@ bool asteroid_system_check_collision(const AsteroidSystem* system, const Player*
 
     return false;
 }
+
+int asteroid_system_save(const AsteroidSystem* system, AsteroidSnapshot* out) {
+    int count = 0;
+    for (int i = 0; i < MAX_ASTEROIDS; i++) {
+        const Asteroid* a = &system->asteroids[i];
+        if (!a->active) continue;
+
+        out[count++] = (AsteroidSnapshot){
+            .x = a->x,
+            .y = a->y,
+            .scale = a->scale,
+            .rotation = a->rotation,
+            .rotation_speed = a->rotation_speed,
+            .slot = (uint8_t)i
+        };
+    }
+    return count;
+}
+
+void asteroid_system_load(AsteroidSystem* system, const AsteroidSnapshot* in, int count) {
+    for (int i = 0; i < MAX_ASTEROIDS; i++) {
+        system->asteroids[i].active = false;
+    }
+
+    // Restore into the original slots so spawning picks the same free slots afterwards
+    for (int i = 0; i < count; i++) {
+        Asteroid* a = &system->asteroids[in[i].slot];
+        a->x = in[i].x;
+        a->y = in[i].y;
+        a->rotation = in[i].rotation;
+        a->rotation_speed = in[i].rotation_speed;
+        a->active = true;
+        if (a->scale != in[i].scale || a->num_points == 0) {
+            build_asteroid_shape(a, in[i].scale);
+        }
+    }
+}
@@ -6,6 +6,9 @@
 #include "config.h"
 #include "wave.h"
 #include "player.h"
+#include "rng.h"
+#include "jobs.h"
+#include "cull.h"
 
 #define MAX_ASTEROID_POINTS 22
 #define MAX_ASTEROIDS 40
@@ -16,6 +19,8 @@
 #define MIN_ASTEROID_SPACING 60   // min distance between asteroids
 #define PARTICLE_LIFETIME 1.0f     // how long particles live in seconds
 #define PARTICLE_SPAWN_RATE 0.016f // spawn every ~1 frame at 60fps
+#define ASTEROID_TRAIL_POINTS 100
+#define ASTEROID_TRAIL_EXTENT 2.6f     // trail reach from the centre, in radii
 
 
 typedef struct {
@@ -46,6 +51,28 @@ typedef struct {
     int num_crater_points;
 } Asteroid;
 
+// Compact form of an active asteroid; the outline and craters are rebuilt from scale
+typedef struct {
+    F22 x;
+    F22 y;
+    float scale;
+    float rotation;
+    float rotation_speed;
+    uint8_t slot;
+} AsteroidSnapshot;
+
+// Screen-space geometry for one asteroid, built on the job workers and then
+// submitted to SDL from the render thread
+typedef struct {
+    SDL_Point trail[ASTEROID_TRAIL_POINTS];
+    SDL_Color trail_colors[ASTEROID_TRAIL_POINTS];  // color of segment ending at j
+    SDL_Point outline[32];
+    SDL_Point craters[32];
+    int num_points;
+    int num_crater_points;
+    bool visible;         // false: culled, nothing else was built
+} AsteroidMesh;
+
 typedef struct {
     Asteroid asteroids[MAX_ASTEROIDS];
     SDL_Point base_shape[MAX_ASTEROID_POINTS];
@@ -53,12 +80,17 @@ typedef struct {
     float particle_spawn_timer;
     uint32_t last_particle_spawn;
     int active_particle_count;
+    Rng rng;
 } AsteroidSystem;
 
-AsteroidSystem asteroid_system_init(void);
+AsteroidSystem asteroid_system_init(uint64_t seed);
 void asteroid_system_update(AsteroidSystem* system, const WaveGenerator* wave);
-void asteroid_system_render(const AsteroidSystem* system, SDL_Renderer* renderer, F22 camera_y_offset, const Player* player);
+// trail_step > 1 builds and draws only every trail_step'th trail point
+void asteroid_system_prepare(const AsteroidSystem* system, JobSystem* jobs, F22 camera_y_offset, const Player* player, int trail_step, AsteroidMesh* meshes);
+void asteroid_system_render(const AsteroidSystem* system, const Canvas* canvas, JobSystem* jobs, F22 camera_y_offset, const Player* player, int trail_step, CullStats* stats);
 bool asteroid_system_check_collision(const AsteroidSystem* system, const Player* player);
+int asteroid_system_save(const AsteroidSystem* system, AsteroidSnapshot* out);
+void asteroid_system_load(AsteroidSystem* system, const AsteroidSnapshot* in, int count);
 static void spawn_asteroid(AsteroidSystem* system, const WaveGenerator* wave, bool spawn_above, float layer_multiplier);
 
 #endif
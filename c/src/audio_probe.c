@@ -0,0 +1,124 @@
+#include "audio_probe.h"
+#include <SDL_mixer.h>
+#include <string.h>
+
+#define AUDIO_PROBE_WARMUP 16   // callbacks ignored while the device settles
+
+typedef struct {
+    uint32_t period_us;
+    uint32_t mix_us;
+} AudioProbeSample;
+
+typedef struct {
+    // Written by the audio thread only. Readers may see a slot mid-update,
+    // which is fine for averages.
+    AudioProbeSample samples[AUDIO_PROBE_HISTORY];
+    SDL_atomic_t head;            // samples written since install
+    SDL_atomic_t underruns;
+    SDL_atomic_t buffer_frames;   // as delivered, SDL may round the request
+
+    int frequency;
+    int frame_bytes;
+    uint64_t ticks_per_second;
+
+    // Audio thread only
+    uint64_t mix_start;
+    uint64_t last_end;
+    uint64_t due;                 // when the device needs the next buffer
+} AudioProbe;
+
+static AudioProbe g_probe;
+
+static uint32_t probe_ticks_to_us(uint64_t ticks) {
+    return (uint32_t)(ticks * 1000000 / g_probe.ticks_per_second);
+}
+
+static void audio_probe_mark_start(int chan, void* stream, int len, void* udata) {
+    g_probe.mix_start = SDL_GetPerformanceCounter();
+}
+
+static void audio_probe_postmix(void* udata, Uint8* stream, int len) {
+    uint64_t now = SDL_GetPerformanceCounter();
+    int frames = len / g_probe.frame_bytes;
+    uint64_t buffer_ticks = g_probe.ticks_per_second * (uint64_t)frames / (uint64_t)g_probe.frequency;
+    int count = SDL_AtomicGet(&g_probe.head);
+
+    AudioProbeSample sample = {0, 0};
+    if (g_probe.last_end) {
+        sample.period_us = probe_ticks_to_us(now - g_probe.last_end);
+    }
+    if (g_probe.mix_start && g_probe.mix_start <= now) {
+        sample.mix_us = probe_ticks_to_us(now - g_probe.mix_start);
+    }
+    g_probe.mix_start = 0;
+    g_probe.last_end = now;
+
+    // The device drains one buffer every buffer_ticks. Finishing a whole
+    // buffer after it was due means it played silence in between. The
+    // schedule re-anchors on late callbacks and runs at most two buffers
+    // ahead on early ones (the depth SDL queues), so neither clock drift nor
+    // bursts add up.
+    if (count >= AUDIO_PROBE_WARMUP && now > g_probe.due + buffer_ticks) {
+        SDL_AtomicAdd(&g_probe.underruns, 1);
+    }
+    uint64_t next = g_probe.due + buffer_ticks;
+    if (count < AUDIO_PROBE_WARMUP || now > next) {
+        next = now;
+    } else if (next > now + 2 * buffer_ticks) {
+        next = now + 2 * buffer_ticks;
+    }
+    g_probe.due = next;
+
+    g_probe.samples[count % AUDIO_PROBE_HISTORY] = sample;
+    SDL_AtomicSet(&g_probe.buffer_frames, frames);
+    SDL_AtomicSet(&g_probe.head, count + 1);
+}
+
+void audio_probe_install(int channel, int frequency, Uint16 format, int channels) {
+    // Nothing on the audio thread touches the probe until the hooks below
+    memset(&g_probe, 0, sizeof(g_probe));
+    g_probe.frequency = frequency;
+    g_probe.frame_bytes = (SDL_AUDIO_BITSIZE(format) / 8) * channels;
+    g_probe.ticks_per_second = SDL_GetPerformanceFrequency();
+
+    // Registered ahead of the channel's other effects so it runs first
+    Mix_RegisterEffect(channel, audio_probe_mark_start, NULL, NULL);
+    Mix_SetPostMix(audio_probe_postmix, NULL);
+}
+
+void audio_probe_remove(int channel) {
+    Mix_SetPostMix(NULL, NULL);
+    Mix_UnregisterEffect(channel, audio_probe_mark_start);
+}
+
+uint32_t audio_probe_underruns(void) {
+    return (uint32_t)SDL_AtomicGet(&g_probe.underruns);
+}
+
+void audio_probe_stats(AudioStats* stats) {
+    memset(stats, 0, sizeof(*stats));
+    int count = SDL_AtomicGet(&g_probe.head);
+    stats->callbacks = (uint32_t)count;
+    stats->underruns = audio_probe_underruns();
+    stats->frequency = g_probe.frequency;
+    stats->buffer_frames = SDL_AtomicGet(&g_probe.buffer_frames);
+    if (g_probe.frequency > 0) {
+        stats->buffer_ms = 1000.0f * stats->buffer_frames / g_probe.frequency;
+    }
+
+    int n = count < AUDIO_PROBE_HISTORY ? count : AUDIO_PROBE_HISTORY;
+    uint64_t mix_total = 0, period_total = 0;
+    int periods = 0;
+    for (int i = 0; i < n; i++) {
+        AudioProbeSample sample = g_probe.samples[(count - 1 - i) % AUDIO_PROBE_HISTORY];
+        mix_total += sample.mix_us;
+        if (sample.mix_us / 1000.0f > stats->mix_max_ms) stats->mix_max_ms = sample.mix_us / 1000.0f;
+        if (sample.period_us == 0) continue;  // first callback
+        period_total += sample.period_us;
+        periods++;
+        if (sample.period_us / 1000.0f > stats->period_max_ms) stats->period_max_ms = sample.period_us / 1000.0f;
+    }
+    if (n > 0) stats->mix_avg_ms = mix_total / 1000.0f / n;
+    if (periods > 0) stats->period_avg_ms = period_total / 1000.0f / periods;
+    stats->latency_ms = stats->buffer_ms + stats->mix_avg_ms;
+}
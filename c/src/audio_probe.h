@@ -0,0 +1,37 @@
+#ifndef AUDIO_PROBE_H
+#define AUDIO_PROBE_H
+
+#include <SDL.h>
+#include <stdint.h>
+
+#define AUDIO_PROBE_HISTORY 512   // callbacks kept for the averages, ~3 s at 256 frames
+
+// Telemetry from inside the audio callback. A Mix_SetPostMix hook timestamps
+// the end of every mix, and an effect on an always-playing channel marks the
+// start of channel mixing. Music decoding happens before the channels are
+// mixed and SDL_mixer has no hook ahead of it, so mix times cover channel
+// mixing and post effects only.
+//
+// An underrun is counted when a callback finishes more than one buffer behind
+// the device clock; callbacks that arrive early in bursts are not penalised.
+typedef struct {
+    uint32_t callbacks;
+    uint32_t underruns;
+    int frequency;
+    int buffer_frames;
+    float buffer_ms;          // one device buffer
+    float latency_ms;         // buffer plus the average mix time
+    float mix_avg_ms;
+    float mix_max_ms;
+    float period_avg_ms;      // time between callbacks
+    float period_max_ms;
+} AudioStats;
+
+// Call right after Mix_OpenAudio; channel must keep playing for mix times
+void audio_probe_install(int channel, int frequency, Uint16 format, int channels);
+void audio_probe_remove(int channel);  // before Mix_CloseAudio
+
+uint32_t audio_probe_underruns(void);  // since the last install
+void audio_probe_stats(AudioStats* stats);
+
+#endif // AUDIO_PROBE_H
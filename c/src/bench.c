@@ -0,0 +1,124 @@
+// Kernel benchmark for the scalar and SIMD web builds, run under node
+// (f22_bench.js and f22_bench_simd.js, see the f22_bench_compare target).
+// Each kernel runs from the same seeded state in both builds and prints its
+// time per call and a checksum of its output, so the builds can be compared
+// for speed and for drift.
+#include "game_state.h"
+#include "asteroid.h"
+#include "explosion.h"
+#include "smoke.h"
+#include <stdio.h>
+
+#define BENCH_SEED 0x5eed
+#define BENCH_CALLS 20000
+#define BENCH_F22_COUNT 1024
+#define BENCH_TICK (1.0f / 60.0f)
+
+typedef double (*BenchKernel)(int calls);   // returns the checksum
+
+static double bench_wave(int calls) {
+    static WavePoint wave[WINDOW_WIDTH];
+    static SDL_Point out[WINDOW_WIDTH];
+    for (int i = 0; i < WINDOW_WIDTH; i++) {
+        wave[i].x = f22_from_float(i);
+        wave[i].y = f22_from_float(WINDOW_HEIGHT / 2 + 120.0f * sinf(i * 0.01f));
+        wave[i].activated = i < WINDOW_WIDTH * 3 / 4;
+    }
+    ScreenPos player_pos = { WINDOW_WIDTH / 4, WINDOW_HEIGHT / 2 };
+
+    double checksum = 0;
+    for (int call = 0; call < calls; call++) {
+        wave_build_vertices(wave, 0, WINDOW_WIDTH, f22_from_float(0.0f), player_pos, call * BENCH_TICK, out);
+        checksum += out[call % (WINDOW_WIDTH / 2)].y;
+    }
+    return checksum;
+}
+
+static double bench_asteroids(int calls) {
+    static AsteroidSystem system;
+    static AsteroidMesh meshes[MAX_ASTEROIDS];
+    system = asteroid_system_init(BENCH_SEED);
+
+    AsteroidSnapshot snapshots[MAX_ASTEROIDS];
+    for (int i = 0; i < MAX_ASTEROIDS; i++) {
+        snapshots[i] = (AsteroidSnapshot){
+            .x = f22_from_float(40.0f + i * 20.0f),
+            .y = f22_from_float(100.0f + (i % 8) * 50.0f),
+            .scale = MIN_ASTEROID_SCALE + (i % 5) * 0.7f,
+            .rotation = i * 9.0f,
+            .slot = (uint8_t)i
+        };
+    }
+    asteroid_system_load(&system, snapshots, MAX_ASTEROIDS);
+    Player player = player_init();
+
+    double checksum = 0;
+    for (int call = 0; call < calls; call++) {
+        asteroid_system_prepare(&system, NULL, f22_from_float(0.0f), &player, 1, meshes);
+        const AsteroidMesh* mesh = &meshes[call % MAX_ASTEROIDS];
+        checksum += mesh->trail[call % ASTEROID_TRAIL_POINTS].x + mesh->trail_colors[1].a;
+    }
+    return checksum;
+}
+
+static double bench_particles(int calls) {
+    static SmokeSystem smoke;
+    static ExplosionSystem explosion;
+    Player player = player_init();
+
+    double checksum = 0;
+    for (int call = 0; call < calls; call++) {
+        // Both systems stop after a few seconds; start them over
+        if (!smoke.active) {
+            smoke = smoke_system_init(BENCH_SEED + call);
+            smoke_system_start(&smoke, &player);
+        }
+        if (!explosion.active) {
+            explosion = explosion_init(BENCH_SEED + call);
+            explosion_start(&explosion, &player);
+        }
+        smoke_system_update(&smoke, NULL, BENCH_TICK);
+        explosion_update(&explosion, NULL, BENCH_TICK);
+        checksum += smoke.particles.x[call % MAX_PARTICLES] + explosion.debris.y[call % MAX_DEBRIS];
+    }
+    return checksum;
+}
+
+static double bench_f22(int calls) {
+    static F22 a[BENCH_F22_COUNT], b[BENCH_F22_COUNT], product[BENCH_F22_COUNT];
+    static float values[BENCH_F22_COUNT];
+    for (int i = 0; i < BENCH_F22_COUNT; i++) {
+        a[i].value = (i * 7919) % 40000 - 20000;
+        b[i].value = (i * 104729) % 4000 - 2000;
+    }
+
+    double checksum = 0;
+    for (int call = 0; call < calls; call++) {
+        f22_mul_n(product, a, b, BENCH_F22_COUNT);
+        f22_to_float_n(values, product, BENCH_F22_COUNT);
+        f22_from_float_n(product, values, BENCH_F22_COUNT);
+        checksum += product[call % BENCH_F22_COUNT].value;
+        checksum += values[call % BENCH_F22_COUNT];
+    }
+    return checksum;
+}
+
+static void bench_run(const char* name, BenchKernel kernel, int calls) {
+    uint64_t start = SDL_GetPerformanceCounter();
+    double checksum = kernel(calls);
+    double elapsed = (SDL_GetPerformanceCounter() - start) * 1e6 / SDL_GetPerformanceFrequency();
+    printf("%-12s %9.2f us/call  checksum %.1f\n", name, elapsed / calls, checksum);
+}
+
+int main(void) {
+    #ifdef __wasm_simd128__
+    printf("SIMD128 build\n");
+    #else
+    printf("Scalar build\n");
+    #endif
+    bench_run("wave", bench_wave, BENCH_CALLS);
+    bench_run("asteroids", bench_asteroids, BENCH_CALLS / 20);   // every asteroid per call
+    bench_run("particles", bench_particles, BENCH_CALLS);
+    bench_run("f22", bench_f22, BENCH_CALLS);
+    return 0;
+}
@@ -0,0 +1,45 @@
+#ifndef CANVAS_H
+#define CANVAS_H
+
+#include <SDL.h>
+#include "raster.h"
+
+// Where the scene is drawn: straight through the SDL renderer, or recorded
+// for the CPU rasterizer (src/raster.h) when raster is set. The calls take
+// the same arguments as the SDL ones they stand for.
+typedef struct {
+    SDL_Renderer* sdl;
+    Raster* raster;      // NULL draws through sdl
+} Canvas;
+
+static inline void canvas_color(const Canvas* canvas, uint8_t r, uint8_t g, uint8_t b, uint8_t a) {
+    if (canvas->raster) raster_set_color(canvas->raster, r, g, b, a);
+    else SDL_SetRenderDrawColor(canvas->sdl, r, g, b, a);
+}
+
+static inline void canvas_clear(const Canvas* canvas) {
+    if (canvas->raster) raster_clear(canvas->raster);
+    else SDL_RenderClear(canvas->sdl);
+}
+
+static inline void canvas_line(const Canvas* canvas, int x0, int y0, int x1, int y1) {
+    if (canvas->raster) raster_line(canvas->raster, x0, y0, x1, y1);
+    else SDL_RenderDrawLine(canvas->sdl, x0, y0, x1, y1);
+}
+
+static inline void canvas_lines(const Canvas* canvas, const SDL_Point* points, int count) {
+    if (canvas->raster) raster_lines(canvas->raster, points, count);
+    else SDL_RenderDrawLines(canvas->sdl, points, count);
+}
+
+static inline void canvas_point(const Canvas* canvas, int x, int y) {
+    if (canvas->raster) raster_point(canvas->raster, x, y);
+    else SDL_RenderDrawPoint(canvas->sdl, x, y);
+}
+
+static inline void canvas_fill_rect(const Canvas* canvas, const SDL_Rect* rect) {
+    if (canvas->raster) raster_fill_rect(canvas->raster, rect);
+    else SDL_RenderFillRect(canvas->sdl, rect);
+}
+
+#endif // CANVAS_H
@@ -0,0 +1,268 @@
+#include "capture.h"
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#ifndef _WIN32
+#include <signal.h>
+#else
+#define popen _popen
+#define pclose _pclose
+#endif
+
+#define CAPTURE_MAX_BUFFERS 256
+
+struct Capture {
+    FILE* file;
+    bool pipe;                 // opened with popen
+    CaptureFormat format;
+    int width, height, fps;
+    size_t frame_bytes;        // one RGBA frame
+    uint8_t* buffers[CAPTURE_MAX_BUFFERS];
+    int num_buffers;
+
+    // Buffer indices, guarded by lock; the pixels themselves are only
+    // touched by whoever holds the index
+    int free_list[CAPTURE_MAX_BUFFERS];
+    int num_free;
+    int queue[CAPTURE_MAX_BUFFERS];    // ring, oldest first
+    int queue_head, queue_count;
+    bool stopping;
+    bool failed;               // a write failed; the rest are dropped
+    CaptureStats stats;
+    SDL_mutex* lock;
+    SDL_cond* ready;
+    SDL_Thread* thread;
+
+    uint8_t* yuv;              // writer's conversion buffer (Y4M)
+};
+
+static size_t capture_yuv_bytes(const Capture* capture) {
+    size_t luma = (size_t)capture->width * capture->height;
+    size_t chroma = (size_t)((capture->width + 1) / 2) * ((capture->height + 1) / 2);
+    return luma + 2 * chroma;
+}
+
+static uint8_t clamp_u8(int v) {
+    return v < 0 ? 0 : v > 255 ? 255 : (uint8_t)v;
+}
+
+// BT.601 full range, as C420jpeg expects; chroma from the average of each
+// 2x2 block
+static void capture_rgba_to_yuv(const Capture* capture, const uint8_t* rgba, uint8_t* yuv) {
+    int w = capture->width, h = capture->height;
+    int cw = (w + 1) / 2, ch = (h + 1) / 2;
+    uint8_t* y_plane = yuv;
+    uint8_t* u_plane = yuv + (size_t)w * h;
+    uint8_t* v_plane = u_plane + (size_t)cw * ch;
+
+    for (int y = 0; y < h; y++) {
+        const uint8_t* p = rgba + (size_t)y * w * 4;
+        for (int x = 0; x < w; x++, p += 4) {
+            y_plane[(size_t)y * w + x] = (uint8_t)((77 * p[0] + 150 * p[1] + 29 * p[2] + 128) >> 8);
+        }
+    }
+
+    for (int cy = 0; cy < ch; cy++) {
+        for (int cx = 0; cx < cw; cx++) {
+            int r = 0, g = 0, b = 0, n = 0;
+            for (int dy = 0; dy < 2; dy++) {
+                int y = cy * 2 + dy;
+                if (y >= h) break;
+                for (int dx = 0; dx < 2; dx++) {
+                    int x = cx * 2 + dx;
+                    if (x >= w) break;
+                    const uint8_t* p = rgba + ((size_t)y * w + x) * 4;
+                    r += p[0];
+                    g += p[1];
+                    b += p[2];
+                    n++;
+                }
+            }
+            r /= n;
+            g /= n;
+            b /= n;
+            // Offset by 128 << 8 so the shift never sees a negative value
+            u_plane[(size_t)cy * cw + cx] = clamp_u8((-43 * r - 85 * g + 128 * b + 32896) >> 8);
+            v_plane[(size_t)cy * cw + cx] = clamp_u8((128 * r - 107 * g - 21 * b + 32896) >> 8);
+        }
+    }
+}
+
+static bool capture_write_frame(Capture* capture, const uint8_t* rgba) {
+    if (capture->format == CAPTURE_RGBA) {
+        return fwrite(rgba, 1, capture->frame_bytes, capture->file) == capture->frame_bytes;
+    }
+    size_t bytes = capture_yuv_bytes(capture);
+    capture_rgba_to_yuv(capture, rgba, capture->yuv);
+    return fputs("FRAME\n", capture->file) >= 0 &&
+           fwrite(capture->yuv, 1, bytes, capture->file) == bytes;
+}
+
+static int capture_writer_main(void* arg) {
+    Capture* capture = (Capture*)arg;
+    SDL_LockMutex(capture->lock);
+    for (;;) {
+        while (capture->queue_count == 0 && !capture->stopping) {
+            SDL_CondWait(capture->ready, capture->lock);
+        }
+        if (capture->queue_count == 0) break;   // stopping, and drained
+
+        int index = capture->queue[capture->queue_head];
+        capture->queue_head = (capture->queue_head + 1) % capture->num_buffers;
+        capture->queue_count--;
+        bool skip = capture->failed;
+        SDL_UnlockMutex(capture->lock);
+
+        bool ok = skip || capture_write_frame(capture, capture->buffers[index]);
+        if (!ok) printf("Capture write failed, dropping the remaining frames\n");
+
+        SDL_LockMutex(capture->lock);
+        capture->free_list[capture->num_free++] = index;
+        capture->stats.queued--;
+        if (skip || !ok) {
+            capture->failed = true;
+            capture->stats.dropped++;
+        } else {
+            capture->stats.written++;
+        }
+    }
+    SDL_UnlockMutex(capture->lock);
+    return 0;
+}
+
+static void capture_free(Capture* capture) {
+    if (capture->file) {
+        if (capture->pipe) pclose(capture->file);
+        else fclose(capture->file);
+    }
+    for (int i = 0; i < capture->num_buffers; i++) {
+        SDL_free(capture->buffers[i]);
+    }
+    SDL_free(capture->yuv);
+    if (capture->ready) SDL_DestroyCond(capture->ready);
+    if (capture->lock) SDL_DestroyMutex(capture->lock);
+    SDL_free(capture);
+}
+
+Capture* capture_start(const char* path, CaptureFormat format, int width, int height,
+                       int fps, size_t budget_bytes) {
+    Capture* capture = SDL_calloc(1, sizeof(Capture));
+    if (!capture) return NULL;
+    capture->format = format;
+    capture->width = width;
+    capture->height = height;
+    capture->fps = fps;
+    capture->frame_bytes = (size_t)width * height * 4;
+
+    // The pool is the whole budget; nothing is allocated while recording
+    size_t count = budget_bytes / capture->frame_bytes;
+    if (count > CAPTURE_MAX_BUFFERS) count = CAPTURE_MAX_BUFFERS;
+    if (count < 2) {
+        printf("Capture budget of %zu bytes holds fewer than 2 frames of %zu bytes\n",
+               budget_bytes, capture->frame_bytes);
+        capture_free(capture);
+        return NULL;
+    }
+    for (size_t i = 0; i < count; i++) {
+        capture->buffers[i] = SDL_calloc(1, capture->frame_bytes);
+        if (!capture->buffers[i]) break;
+        capture->free_list[capture->num_buffers] = capture->num_buffers;
+        capture->num_buffers++;
+    }
+    capture->num_free = capture->num_buffers;
+    if (format == CAPTURE_Y4M) capture->yuv = SDL_malloc(capture_yuv_bytes(capture));
+    if (capture->num_buffers < 2 || (format == CAPTURE_Y4M && !capture->yuv)) {
+        printf("Not enough memory for capture buffers\n");
+        capture_free(capture);
+        return NULL;
+    }
+
+    if (path[0] == '|') {
+        #ifndef _WIN32
+        // An encoder that exits early should fail the write, not end the game
+        signal(SIGPIPE, SIG_IGN);
+        #endif
+        capture->file = popen(path + 1, "w");
+        capture->pipe = true;
+    } else {
+        capture->file = fopen(path, "wb");
+    }
+    if (!capture->file) {
+        printf("Cannot open capture output %s\n", path);
+        capture_free(capture);
+        return NULL;
+    }
+    if (format == CAPTURE_Y4M) {
+        fprintf(capture->file, "YUV4MPEG2 W%d H%d F%d:1 Ip A1:1 C420jpeg\n", width, height, fps);
+    }
+
+    capture->lock = SDL_CreateMutex();
+    capture->ready = SDL_CreateCond();
+    capture->thread = capture->lock && capture->ready ?
+        SDL_CreateThread(capture_writer_main, "f22_capture", capture) : NULL;
+    if (!capture->thread) {
+        printf("Failed to start the capture writer: %s\n", SDL_GetError());
+        capture_free(capture);
+        return NULL;
+    }
+
+    printf("Capturing %dx%d at %d fps to %s, %d buffers (%.0f MB, %.1f s of writer lag)\n",
+           width, height, fps, path, capture->num_buffers,
+           capture->num_buffers * (double)capture->frame_bytes / (1024 * 1024),
+           (double)capture->num_buffers / fps);
+    if (format == CAPTURE_RGBA) {
+        printf("Raw frames; e.g. ffmpeg -f rawvideo -pixel_format rgba -video_size %dx%d -framerate %d -i %s out.mp4\n",
+               width, height, fps, path[0] == '|' ? "-" : path);
+    }
+    return capture;
+}
+
+void capture_frame(Capture* capture, SDL_Renderer* renderer) {
+    SDL_LockMutex(capture->lock);
+    if (capture->failed || capture->num_free == 0) {
+        capture->stats.dropped++;
+        SDL_UnlockMutex(capture->lock);
+        return;
+    }
+    int index = capture->free_list[--capture->num_free];
+    SDL_UnlockMutex(capture->lock);
+
+    // Read back outside the lock; the rect keeps a larger viewport from
+    // writing past the buffer
+    SDL_Rect rect = { 0, 0, capture->width, capture->height };
+    bool ok = SDL_RenderReadPixels(renderer, &rect, SDL_PIXELFORMAT_RGBA32,
+                                   capture->buffers[index], capture->width * 4) == 0;
+
+    SDL_LockMutex(capture->lock);
+    if (ok) {
+        int tail = (capture->queue_head + capture->queue_count) % capture->num_buffers;
+        capture->queue[tail] = index;
+        capture->queue_count++;
+        capture->stats.queued++;
+        SDL_CondSignal(capture->ready);
+    } else {
+        capture->free_list[capture->num_free++] = index;
+        capture->stats.dropped++;
+    }
+    SDL_UnlockMutex(capture->lock);
+}
+
+CaptureStats capture_stats(Capture* capture) {
+    SDL_LockMutex(capture->lock);
+    CaptureStats stats = capture->stats;
+    SDL_UnlockMutex(capture->lock);
+    return stats;
+}
+
+void capture_stop(Capture* capture) {
+    if (!capture) return;
+    SDL_LockMutex(capture->lock);
+    capture->stopping = true;
+    SDL_CondSignal(capture->ready);
+    SDL_UnlockMutex(capture->lock);
+    SDL_WaitThread(capture->thread, NULL);
+
+    printf("Capture finished: %d frames written, %d dropped\n",
+           capture->stats.written, capture->stats.dropped);
+    capture_free(capture);
+}
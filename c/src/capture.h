@@ -0,0 +1,44 @@
+#ifndef CAPTURE_H
+#define CAPTURE_H
+
+#include <SDL.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#define CAPTURE_DEFAULT_BUDGET_MB 256
+#define CAPTURE_MAX_BUDGET_MB 8192     // about 250 frames at 4K
+
+typedef enum {
+    CAPTURE_RGBA,        // raw frames, 4 bytes per pixel, no header
+    CAPTURE_Y4M          // YUV4MPEG2, 4:2:0 full range (C420jpeg)
+} CaptureFormat;
+
+typedef struct {
+    int written;         // frames on disk (or in the pipe)
+    int dropped;         // frames skipped because every buffer was queued
+    int queued;          // read back, waiting for the writer
+} CaptureStats;
+
+// Records the rendered frames for external encoders. Each frame is read back
+// from the render target into one of a fixed pool of buffers, sized from the
+// memory budget at start, and a writer thread streams the queue to the file.
+// The render thread only takes a lock long enough to move a buffer index, so
+// it never waits on disk; when the writer falls behind and no buffer is free
+// the frame is dropped and counted instead.
+typedef struct Capture Capture;
+
+// path is a file, or "|command" to pipe the frames into a program (for
+// example "|ffmpeg -i - clip.mp4" with Y4M). width and height are the
+// renderer's output size. Returns NULL (with a message) on failure.
+Capture* capture_start(const char* path, CaptureFormat format, int width, int height,
+                       int fps, size_t budget_bytes);
+
+// Call after the frame is drawn and before SDL_RenderPresent
+void capture_frame(Capture* capture, SDL_Renderer* renderer);
+
+CaptureStats capture_stats(Capture* capture);
+
+// Writes out whatever is queued, stops the writer and closes the output
+void capture_stop(Capture* capture);
+
+#endif // CAPTURE_H
@@ -0,0 +1,37 @@
+#ifndef CULL_H
+#define CULL_H
+
+#include <stdbool.h>
+#include "config.h"
+
+#define CULL_MARGIN 32   // px past the window edges that still count as on screen
+
+// Drawn and skipped counts for one kind of entity in one frame
+typedef struct {
+    int drawn;
+    int culled;
+} CullCount;
+
+typedef struct {
+    CullCount asteroids;
+    CullCount wave_segments;
+    CullCount debris;
+    CullCount sparks;
+} CullStats;
+
+// True if the screen-space box overlaps the window grown by CULL_MARGIN
+static inline bool cull_box_visible(float min_x, float min_y, float max_x, float max_y) {
+    return max_x >= -CULL_MARGIN && min_x <= WINDOW_WIDTH + CULL_MARGIN &&
+           max_y >= -CULL_MARGIN && min_y <= WINDOW_HEIGHT + CULL_MARGIN;
+}
+
+static inline bool cull_circle_visible(float x, float y, float radius) {
+    return cull_box_visible(x - radius, y - radius, x + radius, y + radius);
+}
+
+static inline void cull_count(CullCount* count, bool visible) {
+    if (visible) count->drawn++;
+    else count->culled++;
+}
+
+#endif // CULL_H
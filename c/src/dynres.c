@@ -0,0 +1,119 @@
+#include "dynres.h"
+#include <math.h>
+#include <stdio.h>
+
+void dynres_init(DynamicResolution* dynres, SDL_Renderer* renderer, int width, int height) {
+    *dynres = (DynamicResolution){ .scale = 1.0f, .width = width, .height = height,
+                                   .high_ms = DYNRES_HIGH_MS, .low_ms = DYNRES_LOW_MS };
+
+    // Allocated once at full size; smaller scales use part of it
+    dynres->target = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA8888,
+                                       SDL_TEXTUREACCESS_TARGET, width, height);
+    if (!dynres->target) {
+        printf("No render target for dynamic resolution: %s\n", SDL_GetError());
+        return;
+    }
+    SDL_SetTextureScaleMode(dynres->target, SDL_ScaleModeLinear);
+}
+
+void dynres_cleanup(DynamicResolution* dynres) {
+    if (dynres->target) {
+        SDL_DestroyTexture(dynres->target);
+        dynres->target = NULL;
+    }
+}
+
+// Pixels of the target the scene covers at the current scale
+static SDL_Rect dynres_region(const DynamicResolution* dynres) {
+    return (SDL_Rect){ 0, 0, (int)lroundf(dynres->width * dynres->scale),
+                       (int)lroundf(dynres->height * dynres->scale) };
+}
+
+void dynres_begin(DynamicResolution* dynres, SDL_Renderer* renderer) {
+    dynres->frame_start = SDL_GetPerformanceCounter();
+    dynres->bound = false;
+    if (!renderer || !dynres->target || dynres->scale >= 1.0f) return;
+    if (SDL_SetRenderTarget(renderer, dynres->target) != 0) return;
+
+    // The viewport is given in scaled coordinates, so set the scale first;
+    // the scene keeps drawing in logical coordinates
+    SDL_RenderSetScale(renderer, dynres->scale, dynres->scale);
+    SDL_RenderSetViewport(renderer, &(SDL_Rect){ 0, 0, dynres->width, dynres->height });
+    dynres->bound = true;
+}
+
+void dynres_end(DynamicResolution* dynres, SDL_Renderer* renderer) {
+    if (!dynres->bound) return;
+
+    SDL_SetRenderTarget(renderer, NULL);
+    SDL_Rect region = dynres_region(dynres);
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
+    SDL_RenderClear(renderer);
+    SDL_RenderCopy(renderer, dynres->target, &region, NULL);
+}
+
+void dynres_submit_done(DynamicResolution* dynres) {
+    dynres->submit_time = SDL_GetPerformanceCounter();
+}
+
+static void dynres_average(float* average, double ms) {
+    if (*average == 0.0f) {
+        *average = (float)ms;
+    } else {
+        *average += ((float)ms - *average) * DYNRES_SMOOTHING;
+    }
+}
+
+void dynres_frame_done(DynamicResolution* dynres) {
+    uint64_t now = SDL_GetPerformanceCounter();
+    uint64_t submit = dynres->submit_time ? dynres->submit_time : now;
+    double to_ms = 1000.0 / SDL_GetPerformanceFrequency();
+    dynres_average(&dynres->average_ms, (now - dynres->frame_start) * to_ms);
+    dynres_average(&dynres->submit_ms, (submit - dynres->frame_start) * to_ms);
+    dynres->submit_time = 0;
+    if (dynres->hold > 0) dynres->hold--;
+
+    if (!dynres->target || dynres->pinned) return;
+    if (dynres->cooldown > 0) {
+        dynres->cooldown--;
+        return;
+    }
+
+    bool over, under;
+    if (dynres->vsync) {
+        // The average settles on the period while every vblank is met
+        over = dynres->average_ms > dynres->period_ms * DYNRES_MISSED_SHARE;
+        under = dynres->hold == 0 && dynres->submit_ms < dynres->low_ms;
+    } else {
+        over = dynres->average_ms > dynres->high_ms;
+        under = dynres->average_ms < dynres->low_ms;
+    }
+
+    float scale = dynres->scale;
+    if (over && scale > DYNRES_MIN_SCALE) {
+        scale = fmaxf(DYNRES_MIN_SCALE, scale - DYNRES_STEP);
+        dynres->hold = DYNRES_HOLD;
+    } else if (under && scale < 1.0f) {
+        scale = fminf(1.0f, scale + DYNRES_STEP);
+    }
+    if (scale == dynres->scale) return;
+
+    // Snap to the step grid so float drift never leaves it just below 1
+    dynres->scale = roundf(scale / DYNRES_STEP) * DYNRES_STEP;
+    dynres->cooldown = DYNRES_COOLDOWN;
+    printf("Render scale %d%% (frame %.2f ms avg, %.2f ms before present)\n",
+           (int)lroundf(dynres->scale * 100.0f), dynres->average_ms, dynres->submit_ms);
+}
+
+void dynres_set_refresh(DynamicResolution* dynres, double period_ms, bool vsync) {
+    if (period_ms <= 0.0) return;
+    dynres->period_ms = (float)period_ms;
+    dynres->vsync = vsync;
+    dynres->high_ms = (float)period_ms * DYNRES_HIGH_SHARE;
+    dynres->low_ms = (float)period_ms * DYNRES_LOW_SHARE;
+}
+
+void dynres_set_scale(DynamicResolution* dynres, float scale) {
+    dynres->scale = fminf(1.0f, fmaxf(DYNRES_MIN_SCALE, scale));
+    dynres->pinned = true;
+}
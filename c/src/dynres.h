@@ -0,0 +1,79 @@
+#ifndef DYNRES_H
+#define DYNRES_H
+
+#include <SDL.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#define DYNRES_MIN_SCALE 0.5f
+#define DYNRES_STEP 0.1f          // scale change per adjustment
+#define DYNRES_HIGH_MS 12.0f      // average frame time that lowers the scale
+#define DYNRES_LOW_MS 8.0f        // and the one that raises it again
+#define DYNRES_HIGH_SHARE 0.72f   // the same limits as shares of a refresh
+#define DYNRES_LOW_SHARE 0.48f    // period (12 and 8 ms at 60 Hz)
+#define DYNRES_SMOOTHING 0.1f     // weight of the newest frame in the average
+#define DYNRES_COOLDOWN 45        // frames after a change before the next one
+#define DYNRES_MISSED_SHARE 1.25f // vsync: average interval, in periods, that means missed vblanks
+#define DYNRES_HOLD 600           // vsync: frames after missed vblanks before the scale may rise
+
+// Dynamic resolution for the scene. Below full scale the scene is drawn
+// into the top-left part of an offscreen target, at scale times the logical
+// size, and stretched over the window; text drawn after dynres_end stays at
+// native resolution.
+//
+// The frame time runs from dynres_begin to after SDL_RenderPresent. Present
+// blocks once the driver has too many frames queued, so a GPU that falls
+// behind shows up there even though the quality governor, which stops
+// before present, never sees it. In the browser present never blocks and
+// only the CPU side counts.
+//
+// With vsync present also waits for the vblank, so the time is a whole
+// number of refresh periods and says nothing about headroom: the scale goes
+// down when vblanks are being missed, and comes back up only when the CPU
+// side (dynres_begin to dynres_submit_done) is well under budget and no
+// vblank was missed for DYNRES_HOLD frames. A GPU-bound frame therefore
+// retries the higher scale every DYNRES_HOLD frames at most. The gap
+// between DYNRES_LOW_MS and DYNRES_HIGH_MS, plus the cooldown, keeps the
+// scale from flipping back and forth at the edge of the budget.
+typedef struct {
+    SDL_Texture* target;      // full logical size; NULL disables scaling
+    int width, height;        // logical size
+    float scale;              // DYNRES_MIN_SCALE .. 1
+    bool bound;               // the scene is going to target this frame
+    bool pinned;              // set by dynres_set_scale; no adapting
+    float high_ms, low_ms;    // DYNRES_HIGH_MS / DYNRES_LOW_MS until dynres_set_refresh
+    float period_ms;          // refresh period; 0 until dynres_set_refresh
+    bool vsync;               // present waits for the vblank
+    float average_ms;         // begin to after present
+    float submit_ms;          // begin to dynres_submit_done
+    int cooldown;
+    int hold;                 // frames left before a vsync frame may scale up
+    uint64_t frame_start;
+    uint64_t submit_time;     // 0 when dynres_submit_done was not called
+} DynamicResolution;
+
+void dynres_init(DynamicResolution* dynres, SDL_Renderer* renderer, int width, int height);
+void dynres_cleanup(DynamicResolution* dynres);
+
+// Redirects drawing to the offscreen target when below full scale. With a
+// NULL renderer it only starts the frame timer, for a caller that scales the
+// scene itself (the CPU rasterizer, src/raster.h).
+void dynres_begin(DynamicResolution* dynres, SDL_Renderer* renderer);
+
+// Back to the window, with the scene stretched over it
+void dynres_end(DynamicResolution* dynres, SDL_Renderer* renderer);
+
+// Call just before SDL_RenderPresent; ends the CPU side of the frame
+void dynres_submit_done(DynamicResolution* dynres);
+
+// Call after SDL_RenderPresent; picks the scale for the next frame
+void dynres_frame_done(DynamicResolution* dynres);
+
+// Scales the limits to the frame period the loop is paced to, so a 144 Hz
+// display with vsync gets a 6.9 ms budget instead of the 60 Hz one
+void dynres_set_refresh(DynamicResolution* dynres, double period_ms, bool vsync);
+
+// Fixes the scale (clamped to DYNRES_MIN_SCALE .. 1) and stops adapting
+void dynres_set_scale(DynamicResolution* dynres, float scale);
+
+#endif // DYNRES_H
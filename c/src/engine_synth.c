@@ -0,0 +1,104 @@
+#include "engine_synth.h"
+#include <math.h>
+#include <string.h>
+
+#define ENGINE_SYNTH_ATTACK_MS 25.0f
+#define ENGINE_SYNTH_RELEASE_MS 120.0f
+#define ENGINE_SYNTH_GLIDE_MS 150.0f   // pitch follows the climb rate this slowly
+#define ENGINE_SYNTH_ROAR 0.7f
+
+// Rumble, detuned rumble, octave and turbine whine
+static const float LANE_RATIO[ENGINE_SYNTH_LANES] = { 1.0f, 1.007f, 2.0f, 23.0f };
+static const float LANE_LEVEL[ENGINE_SYNTH_LANES] = { 0.24f, 0.18f, 0.11f, 0.04f };
+
+static float block_coefficient(float ms, float sample_rate) {
+    float blocks_per_second = sample_rate / ENGINE_SYNTH_BLOCK;
+    return 1.0f - expf(-1000.0f / (ms * blocks_per_second));
+}
+
+void engine_synth_init(EngineSynth* synth, int sample_rate) {
+    memset(synth, 0, sizeof(*synth));
+    synth->sample_rate = (float)sample_rate;
+    synth->noise = 0x9E3779B9u;
+    synth->attack = block_coefficient(ENGINE_SYNTH_ATTACK_MS, synth->sample_rate);
+    synth->release = block_coefficient(ENGINE_SYNTH_RELEASE_MS, synth->sample_rate);
+    synth->glide = block_coefficient(ENGINE_SYNTH_GLIDE_MS, synth->sample_rate);
+}
+
+void engine_synth_set_climb(EngineSynth* synth, float climb) {
+    if (climb > 1.0f) climb = 1.0f;
+    if (climb < -1.0f) climb = -1.0f;
+    SDL_AtomicSet(&synth->climb, (int)(climb * 1000.0f));
+}
+
+// Adds one band-limited sawtooth. Every sample's phase comes straight from
+// the block start, and both PolyBLEP corrections are always computed and then
+// selected, so the loop has no branches.
+static void synth_saw_lane(float* out, int frames, float phase, float inc, float level) {
+    float inv = 1.0f / inc;
+    for (int i = 0; i < frames; i++) {
+        float t = phase + (float)i * inc;
+        t -= (float)(int)t;  // t >= 0, so truncation is floor
+        float saw = 2.0f * t - 1.0f;
+
+        float a = t * inv;
+        float b = (t - 1.0f) * inv;
+        float rise = 2.0f * a - a * a - 1.0f;
+        float fall = b * b + 2.0f * b + 1.0f;
+        saw -= t < inc ? rise : 0.0f;
+        saw -= t > 1.0f - inc ? fall : 0.0f;
+        out[i] += saw * level;
+    }
+}
+
+void engine_synth_render(EngineSynth* synth, bool thrust, float* out, int frames) {
+    float target = thrust ? 1.0f : 0.0f;
+    float gain_start = synth->gain;
+    synth->gain += (target - synth->gain) * (target > synth->gain ? synth->attack : synth->release);
+    if (target == 0.0f && synth->gain < 1e-4f) synth->gain = 0.0f;
+    float gain_end = synth->gain;
+
+    float climb = SDL_AtomicGet(&synth->climb) / 1000.0f;
+    synth->spool += (climb - synth->spool) * synth->glide;
+
+    memset(out, 0, sizeof(float) * (size_t)frames);
+    if (gain_start == 0.0f && gain_end == 0.0f) return;
+
+    // Half an octave either way with the climb rate, and a spool-up sag
+    // while the gain is still rising
+    float f0 = ENGINE_SYNTH_BASE_HZ * exp2f(synth->spool * 0.5f) * (0.75f + 0.25f * gain_end);
+    for (int lane = 0; lane < ENGINE_SYNTH_LANES; lane++) {
+        float inc = f0 * LANE_RATIO[lane] / synth->sample_rate;
+        if (inc >= 0.5f) continue;  // above Nyquist
+        float level = lane == ENGINE_SYNTH_LANES - 1 ? LANE_LEVEL[lane] * gain_end : LANE_LEVEL[lane];
+        synth_saw_lane(out, frames, synth->phase[lane], inc, level);
+
+        float phase = synth->phase[lane] + (float)frames * inc;
+        synth->phase[lane] = phase - (float)(int)phase;
+    }
+
+    // Roar: white noise through two one-pole low-passes that open up with
+    // thrust and steep climbs or dives
+    float cutoff = 300.0f + 2500.0f * gain_end * (0.6f + 0.4f * fabsf(synth->spool));
+    float c = 1.0f - expf(-2.0f * (float)M_PI * cutoff / synth->sample_rate);
+    uint32_t noise = synth->noise;
+    float low1 = synth->low1, low2 = synth->low2;
+    for (int i = 0; i < frames; i++) {
+        noise ^= noise << 13;
+        noise ^= noise >> 17;
+        noise ^= noise << 5;
+        float white = (float)(int32_t)noise * (1.0f / 2147483648.0f);
+        low1 += (white - low1) * c;
+        low2 += (low1 - low2) * c;
+        out[i] += low2 * ENGINE_SYNTH_ROAR;
+    }
+    synth->noise = noise;
+    synth->low1 = low1;
+    synth->low2 = low2;
+
+    // Ramp the gain across the block so parameter steps never click
+    float step = (gain_end - gain_start) / (float)frames;
+    for (int i = 0; i < frames; i++) {
+        out[i] *= gain_start + step * (float)(i + 1);
+    }
+}
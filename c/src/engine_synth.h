@@ -0,0 +1,39 @@
+#ifndef ENGINE_SYNTH_H
+#define ENGINE_SYNTH_H
+
+#include <SDL.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#define ENGINE_SYNTH_BLOCK 64        // frames per parameter update
+#define ENGINE_SYNTH_LANES 4         // oscillators
+#define ENGINE_SYNTH_BASE_HZ 62.0f   // rumble fundamental in level flight
+
+// Jet engine voice built from band-limited (PolyBLEP) sawtooth oscillators
+// and low-passed noise. Parameters move once per block and are ramped across
+// it; the oscillator loops compute each sample's phase in closed form, so
+// they have no loop-carried state and the compiler vectorizes them.
+//
+// Used when the game is built with F22_SYNTH_ENGINE, replacing engine.mp3.
+typedef struct {
+    SDL_atomic_t climb;        // -1000 (diving) .. 1000 (full climb), any thread
+
+    // Audio thread only
+    float sample_rate;
+    float phase[ENGINE_SYNTH_LANES];
+    float gain;
+    float spool;               // smoothed climb
+    float low1, low2;          // noise filter state
+    uint32_t noise;
+    float attack, release, glide;   // per-block smoothing coefficients
+} EngineSynth;
+
+void engine_synth_init(EngineSynth* synth, int sample_rate);
+
+// Climb rate normalised to -1..1; may be called from any thread
+void engine_synth_set_climb(EngineSynth* synth, float climb);
+
+// Renders frames (<= ENGINE_SYNTH_BLOCK) of mono samples in -1..1
+void engine_synth_render(EngineSynth* synth, bool thrust, float* out, int frames);
+
+#endif // ENGINE_SYNTH_H
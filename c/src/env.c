@@ -0,0 +1,168 @@
+#include "env.h"
+#include "game_state.h"
+#include "jobs.h"
+#include <SDL.h>
+#include <math.h>
+
+#define ENV_FIXED_TIME_STEP (1.0f / 60.0f)
+#define ENV_GRAIN 16  // instances per job chunk
+
+struct F22Env {
+    GameState* states;       // one contiguous block, num_envs entries
+    uint64_t* episodes;
+    int num_envs;
+    uint64_t seed;
+    JobSystem* jobs;
+
+    // Arguments of the step in flight
+    const uint8_t* actions;
+    float* observations;
+    float* rewards;
+    uint8_t* dones;
+};
+
+static uint64_t episode_seed(const F22Env* env, int index) {
+    // splitmix64 over (seed, instance, episode) so every episode gets its own streams
+    uint64_t z = env->seed + 0x9E3779B97F4A7C15ULL * ((uint64_t)index + 1) + env->episodes[index];
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+static void env_reset_instance(F22Env* env, int index) {
+    GameState* state = &env->states[index];
+    *state = game_state_create(episode_seed(env, index));
+    game_state_start(state);
+    env->episodes[index]++;
+}
+
+static void env_observe(const GameState* state, float* obs) {
+    float player_x = f22_to_float(state->player.position.x);
+    float player_y = f22_to_float(state->player.position.y);
+
+    obs[0] = player_y;
+    obs[1] = f22_to_float(state->player.velocity.y);
+    obs[2] = player_x;
+
+    float* path = obs + 3;
+    for (int i = 0; i < F22_ENV_PATH_SAMPLES; i++) {
+        int x = (int)player_x + i * F22_ENV_PATH_STRIDE;
+        if (x < 0) x = 0;
+        if (x > GHOST_WIDTH - 1) x = GHOST_WIDTH - 1;
+        path[i] = f22_to_float(state->wave.points[x].y) - player_y;
+    }
+
+    // Keep the K closest active asteroids, sorted by insertion
+    float nearest_dist[F22_ENV_NEAREST_ASTEROIDS];
+    const Asteroid* nearest[F22_ENV_NEAREST_ASTEROIDS];
+    int num_nearest = 0;
+    for (int i = 0; i < MAX_ASTEROIDS; i++) {
+        const Asteroid* a = &state->asteroid_system.asteroids[i];
+        if (!a->active) continue;
+
+        float dx = f22_to_float(a->x) - player_x;
+        float dy = f22_to_float(a->y) - player_y;
+        float dist = dx * dx + dy * dy;
+
+        int slot = num_nearest;
+        while (slot > 0 && nearest_dist[slot - 1] > dist) {
+            if (slot < F22_ENV_NEAREST_ASTEROIDS) {
+                nearest_dist[slot] = nearest_dist[slot - 1];
+                nearest[slot] = nearest[slot - 1];
+            }
+            slot--;
+        }
+        if (slot < F22_ENV_NEAREST_ASTEROIDS) {
+            nearest_dist[slot] = dist;
+            nearest[slot] = a;
+            if (num_nearest < F22_ENV_NEAREST_ASTEROIDS) num_nearest++;
+        }
+    }
+
+    float* rocks = path + F22_ENV_PATH_SAMPLES;
+    for (int i = 0; i < F22_ENV_NEAREST_ASTEROIDS; i++) {
+        if (i < num_nearest) {
+            rocks[i * 3 + 0] = f22_to_float(nearest[i]->x) - player_x;
+            rocks[i * 3 + 1] = f22_to_float(nearest[i]->y) - player_y;
+            rocks[i * 3 + 2] = ASTEROID_BASE_SIZE * nearest[i]->scale * 0.5f;
+        } else {
+            rocks[i * 3 + 0] = 0.0f;
+            rocks[i * 3 + 1] = 0.0f;
+            rocks[i * 3 + 2] = 0.0f;
+        }
+    }
+}
+
+static void env_reset_range(void* ctx, int begin, int end) {
+    F22Env* env = (F22Env*)ctx;
+    for (int i = begin; i < end; i++) {
+        env_reset_instance(env, i);
+        if (env->observations) {
+            env_observe(&env->states[i], env->observations + (size_t)i * F22_ENV_OBS_SIZE);
+        }
+    }
+}
+
+static void env_step_range(void* ctx, int begin, int end) {
+    F22Env* env = (F22Env*)ctx;
+    for (int i = begin; i < end; i++) {
+        GameState* state = &env->states[i];
+        bool thrust = (env->actions[i] & F22_ENV_ACTION_THRUST) != 0;
+
+        float score_before = state->scoring.score;
+        game_state_update(state, thrust, ENV_FIXED_TIME_STEP);
+        bool done = game_state_check_collisions(state);
+
+        if (env->rewards) env->rewards[i] = state->scoring.score - score_before;
+        if (env->dones) env->dones[i] = done;
+        if (done) env_reset_instance(env, i);
+        if (env->observations) {
+            env_observe(state, env->observations + (size_t)i * F22_ENV_OBS_SIZE);
+        }
+    }
+}
+
+F22Env* f22_env_create(int num_envs, uint64_t seed, int num_threads) {
+    if (num_envs <= 0) return NULL;
+
+    F22Env* env = SDL_calloc(1, sizeof(F22Env));
+    if (!env) return NULL;
+
+    env->num_envs = num_envs;
+    env->seed = seed;
+    env->states = SDL_SIMDAlloc(sizeof(GameState) * (size_t)num_envs);
+    env->episodes = SDL_calloc((size_t)num_envs, sizeof(uint64_t));
+    if (!env->states || !env->episodes) {
+        f22_env_destroy(env);
+        return NULL;
+    }
+
+    env->jobs = jobs_create(num_threads > 0 ? num_threads - 1 : -1);
+    f22_env_reset(env, NULL);
+    return env;
+}
+
+void f22_env_destroy(F22Env* env) {
+    if (!env) return;
+    jobs_destroy(env->jobs);
+    SDL_SIMDFree(env->states);
+    SDL_free(env->episodes);
+    SDL_free(env);
+}
+
+int f22_env_num_envs(const F22Env* env) {
+    return env->num_envs;
+}
+
+void f22_env_reset(F22Env* env, float* observations) {
+    env->observations = observations;
+    jobs_parallel_for(env->jobs, env->num_envs, ENV_GRAIN, env_reset_range, env);
+}
+
+void f22_env_step(F22Env* env, const uint8_t* actions, float* observations, float* rewards, uint8_t* dones) {
+    env->actions = actions;
+    env->observations = observations;
+    env->rewards = rewards;
+    env->dones = dones;
+    jobs_parallel_for(env->jobs, env->num_envs, ENV_GRAIN, env_step_range, env);
+}
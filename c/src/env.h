@@ -0,0 +1,39 @@
+#ifndef ENV_H
+#define ENV_H
+
+#include <stdint.h>
+
+// Vectorized environment for training/evaluating autopilots: steps N
+// independent games per call across a thread pool.
+//
+// Observation layout per instance (F22_ENV_OBS_SIZE floats, world units):
+//   [0]  player y        [1] player vertical velocity    [2] player x
+//   [3 .. 3+PATH)        ghost path y minus player y, sampled every
+//                        F22_ENV_PATH_STRIDE units ahead of the player
+//   [.. + 3*NEAREST)     nearest asteroids as (dx, dy, radius), closest first;
+//                        radius 0 marks an empty slot
+#define F22_ENV_PATH_SAMPLES 32
+#define F22_ENV_PATH_STRIDE 16
+#define F22_ENV_NEAREST_ASTEROIDS 4
+#define F22_ENV_OBS_SIZE (3 + F22_ENV_PATH_SAMPLES + F22_ENV_NEAREST_ASTEROIDS * 3)
+
+#define F22_ENV_ACTION_THRUST 0x1
+
+typedef struct F22Env F22Env;
+
+// num_threads <= 0 uses every core
+F22Env* f22_env_create(int num_envs, uint64_t seed, int num_threads);
+void f22_env_destroy(F22Env* env);
+int f22_env_num_envs(const F22Env* env);
+
+// Restarts every instance; observations may be NULL
+void f22_env_reset(F22Env* env, float* observations);
+
+// actions: one byte per instance (F22_ENV_ACTION_* bits).
+// rewards: score gained this step (from update_scoring).
+// dones: set when the instance crashed; it is reset immediately and the
+// returned observation is the first one of the new episode.
+// Any output pointer may be NULL.
+void f22_env_step(F22Env* env, const uint8_t* actions, float* observations, float* rewards, uint8_t* dones);
+
+#endif // ENV_H
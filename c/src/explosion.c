@@ -17,62 +17,65 @@ static const SDL_Point CANOPY_SHAPE[] = {
     {32, -5}, {26, -10}, {16, -12}, {14, -11}, {32, -5}
 };
 
-ExplosionSystem explosion_init(void) {
+ExplosionSystem explosion_init(uint64_t seed) {
     ExplosionSystem system = {0};
     system.active = false;
+    system.rng = rng_init(seed, RNG_STREAM_EXPLOSION);
     return system;
 }
 
-void create_debris_piece(Debris* debris, const SDL_Point* shape, int num_points, 
+void create_debris_piece(DebrisSet* debris, int index, Rng* rng, const SDL_Point* shape, int num_points, 
                         float x, float y, float base_vx, float spread) {
-    debris->active = true;
-    debris->lifetime = 0;
-    debris->x = x;
-    debris->y = y;
+    DebrisShape* piece = &debris->shape[index];
+    debris->active[index] = true;
+    debris->lifetime[index] = 0;
+    debris->x[index] = x;
+    debris->y[index] = y;
     
     // Copy shape points
-    memcpy(debris->points, shape, num_points * sizeof(SDL_Point));
-    debris->num_points = num_points;
+    memcpy(piece->points, shape, num_points * sizeof(SDL_Point));
+    piece->num_points = num_points;
     
     // Random velocity with spread
-    float angle = ((float)rand() / (float)RAND_MAX) * 2 * M_PI;
-    float speed = 2.0f + ((float)rand() / (float)RAND_MAX) * 4.0f;
-    debris->vx = base_vx + cosf(angle) * speed * spread;
-    debris->vy = sinf(angle) * speed * spread;
+    float angle = rng_float(rng) * 2 * M_PI;
+    float speed = 2.0f + rng_float(rng) * 4.0f;
+    debris->vx[index] = base_vx + cosf(angle) * speed * spread;
+    debris->vy[index] = sinf(angle) * speed * spread;
     
     // Random rotation
-    debris->rotation = ((float)rand() / (float)RAND_MAX) * 360.0f;
-    debris->rot_speed = -180.0f + ((float)rand() / (float)RAND_MAX) * 360.0f;
+    debris->rotation[index] = rng_float(rng) * 360.0f;
+    debris->rot_speed[index] = -180.0f + rng_float(rng) * 360.0f;
     
     // Random scale variation
-    debris->scale = 0.8f + ((float)rand() / (float)RAND_MAX) * 0.4f;
+    piece->scale = 0.8f + rng_float(rng) * 0.4f;
     
     // Hot metal colors
-    debris->r = 230 + ((float)rand() / (float)RAND_MAX) * 25;
-    debris->g = 120 + ((float)rand() / (float)RAND_MAX) * 80;
-    debris->b = 50 + ((float)rand() / (float)RAND_MAX) * 30;
+    piece->r = 230 + rng_float(rng) * 25;
+    piece->g = 120 + rng_float(rng) * 80;
+    piece->b = 50 + rng_float(rng) * 30;
 }
 
-void create_spark(Spark* spark, float x, float y, float base_vx) {
-    spark->active = true;
-    spark->lifetime = 0;
-    spark->x = x;
-    spark->y = y;
+void create_spark(SparkSet* sparks, int index, Rng* rng, float x, float y, float base_vx) {
+    sparks->active[index] = true;
+    sparks->lifetime[index] = 0;
+    sparks->x[index] = x;
+    sparks->y[index] = y;
     
-    float angle = ((float)rand() / (float)RAND_MAX) * 2 * M_PI;
-    float speed = 1.0f + ((float)rand() / (float)RAND_MAX) * 6.0f;
-    spark->vx = base_vx + cosf(angle) * speed;
-    spark->vy = sinf(angle) * speed;
+    float angle = rng_float(rng) * 2 * M_PI;
+    float speed = 1.0f + rng_float(rng) * 6.0f;
+    sparks->vx[index] = base_vx + cosf(angle) * speed;
+    sparks->vy[index] = sinf(angle) * speed;
     
     // bright orange/yellow colors
-    spark->r = 255;
-    spark->g = 180 + ((float)rand() / (float)RAND_MAX) * 75;
-    spark->b = ((float)rand() / (float)RAND_MAX) * 50;
-    spark->a = 255;
+    sparks->r[index] = 255;
+    sparks->g[index] = 180 + rng_float(rng) * 75;
+    sparks->b[index] = rng_float(rng) * 50;
+    sparks->a[index] = 255;
 }
 
 void explosion_start(ExplosionSystem* system, const Player* player) {
     if (system->active) return;
+    Rng* rng = &system->rng;
     
     system->active = true;
     system->time = 0;
@@ -85,43 +88,196 @@ void explosion_start(ExplosionSystem* system, const Player* player) {
     
     // Create wing debris
     for (int i = 0; i < 8; i++) {
-        create_debris_piece(&system->debris[i], WING_SHAPE, 5, x, y, base_vx, 1.0f);
+        create_debris_piece(&system->debris, i, rng, WING_SHAPE, 5, x, y, base_vx, 1.0f);
     }
     
     // Create tail debris
     for (int i = 8; i < 16; i++) {
-        create_debris_piece(&system->debris[i], TAIL_SHAPE, 5, x, y, base_vx, 1.2f);
+        create_debris_piece(&system->debris, i, rng, TAIL_SHAPE, 5, x, y, base_vx, 1.2f);
     }
     
     // Create nose debris
     for (int i = 16; i < 24; i++) {
-        create_debris_piece(&system->debris[i], NOSE_SHAPE, 5, x, y, base_vx, 0.8f);
+        create_debris_piece(&system->debris, i, rng, NOSE_SHAPE, 5, x, y, base_vx, 0.8f);
     }
     
     // Create canopy debris
     for (int i = 24; i < 32; i++) {
-        create_debris_piece(&system->debris[i], CANOPY_SHAPE, 5, x, y, base_vx, 1.1f);
+        create_debris_piece(&system->debris, i, rng, CANOPY_SHAPE, 5, x, y, base_vx, 1.1f);
     }
     
     // Create smaller random debris
     for (int i = 32; i < MAX_DEBRIS; i++) {
         SDL_Point small_shape[] = {
             {0, 0}, 
-            {((float)rand() / (float)RAND_MAX) * 10, ((float)rand() / (float)RAND_MAX) * 10},
-            {((float)rand() / (float)RAND_MAX) * 10, ((float)rand() / (float)RAND_MAX) * -10},
+            {rng_float(rng) * 10, rng_float(rng) * 10},
+            {rng_float(rng) * 10, rng_float(rng) * -10},
             {0, 0}
         };
-        create_debris_piece(&system->debris[i], small_shape, 4, x, y, base_vx, 1.5f);
+        create_debris_piece(&system->debris, i, rng, small_shape, 4, x, y, base_vx, 1.5f);
     }
     
     // Create initial spark burst
     for (int i = 0; i < MAX_SPARKS; i++) {
-        create_spark(&system->sparks[i], x, y, base_vx);
+        create_spark(&system->sparks, i, rng, x, y, base_vx);
     }
 }
 
-void explosion_update(ExplosionSystem* system, float delta_time) {
+#define EXPLOSION_GRAIN 16  // debris/sparks per job; the integration is cheap
+
+typedef struct {
+    ExplosionSystem* system;
+    float delta_time;
+} ExplosionJob;
+
+#define EXPLOSION_DRAG 0.99f
+#define SPARK_LIFETIME 0.5f    // sparks are shorter-lived
+
+static void update_debris(DebrisSet* d, int i, float delta_time) {
+    d->lifetime[i] += delta_time;
+    if (d->lifetime[i] > EXPLOSION_DURATION) {
+        d->active[i] = false;
+        return;
+    }
+    
+    // Update position
+    d->x[i] += d->vx[i];
+    d->y[i] += d->vy[i];
+    
+    // Apply gravity and drag
+    d->vy[i] += f22_to_float(GRAVITY);
+    d->vx[i] *= EXPLOSION_DRAG;
+    d->vy[i] *= EXPLOSION_DRAG;
+    
+    // Update rotation
+    d->rotation[i] += d->rot_speed[i] * delta_time;
+    d->rot_speed[i] *= 0.98f;  // slow rotation over time
+}
+
+static void update_spark(SparkSet* s, int i, float delta_time) {
+    s->lifetime[i] += delta_time;
+    if (s->lifetime[i] > SPARK_LIFETIME) {
+        s->active[i] = false;
+        return;
+    }
+    
+    s->x[i] += s->vx[i];
+    s->y[i] += s->vy[i];
+    s->vy[i] += f22_to_float(GRAVITY) * 0.5f;  // lighter gravity for sparks
+    s->vx[i] *= EXPLOSION_DRAG;
+    s->vy[i] *= EXPLOSION_DRAG;
+    
+    // Fade out
+    float fade = 1.0f - (s->lifetime[i] / SPARK_LIFETIME);
+    s->a[i] = (uint8_t)(255.0f * fade);
+}
+
+#ifdef __wasm_simd128__
+// Lanes of pieces i..i+3 that are active, as a bitmask and a select mask
+static int active_lanes(const bool* active, int i, v128_t* mask) {
+    *mask = wasm_i32x4_make(-active[i], -active[i + 1], -active[i + 2], -active[i + 3]);
+    return active[i] | active[i + 1] << 1 | active[i + 2] << 2 | active[i + 3] << 3;
+}
+
+// Replaces the lanes of field[i..i+3] selected by mask
+static void store_lanes(float* field, int i, v128_t value, v128_t mask) {
+    wasm_v128_store(&field[i], wasm_v128_bitselect(value, wasm_v128_load(&field[i]), mask));
+}
+
+// Pieces i..i+3 with the same arithmetic as update_debris. Inactive lanes
+// keep their values and expired ones only their new lifetime.
+static void update_debris_x4(DebrisSet* d, int i, float delta_time) {
+    v128_t active_mask;
+    int active = active_lanes(d->active, i, &active_mask);
+    if (!active) return;
+    v128_t drag = wasm_f32x4_splat(EXPLOSION_DRAG);
+
+    v128_t lifetime = wasm_f32x4_add(wasm_v128_load(&d->lifetime[i]), wasm_f32x4_splat(delta_time));
+    v128_t live = wasm_v128_andnot(active_mask, wasm_f32x4_gt(lifetime, wasm_f32x4_splat(EXPLOSION_DURATION)));
+    store_lanes(d->lifetime, i, lifetime, active_mask);
+
+    v128_t vx = wasm_v128_load(&d->vx[i]);
+    v128_t vy = wasm_v128_load(&d->vy[i]);
+    store_lanes(d->x, i, wasm_f32x4_add(wasm_v128_load(&d->x[i]), vx), live);
+    store_lanes(d->y, i, wasm_f32x4_add(wasm_v128_load(&d->y[i]), vy), live);
+    store_lanes(d->vy, i, wasm_f32x4_mul(wasm_f32x4_add(vy, wasm_f32x4_splat(f22_to_float(GRAVITY))), drag), live);
+    store_lanes(d->vx, i, wasm_f32x4_mul(vx, drag), live);
+
+    v128_t rot_speed = wasm_v128_load(&d->rot_speed[i]);
+    store_lanes(d->rotation, i, wasm_f32x4_add(wasm_v128_load(&d->rotation[i]),
+                                               wasm_f32x4_mul(rot_speed, wasm_f32x4_splat(delta_time))), live);
+    store_lanes(d->rot_speed, i, wasm_f32x4_mul(rot_speed, wasm_f32x4_splat(0.98f)), live);
+
+    int expired = active & ~wasm_i32x4_bitmask(live);
+    for (int k = 0; k < 4; k++) {
+        if (expired & (1 << k)) d->active[i + k] = false;
+    }
+}
+
+// Sparks i..i+3 with the same arithmetic as update_spark
+static void update_sparks_x4(SparkSet* s, int i, float delta_time) {
+    v128_t active_mask;
+    int active = active_lanes(s->active, i, &active_mask);
+    if (!active) return;
+    v128_t drag = wasm_f32x4_splat(EXPLOSION_DRAG);
+
+    v128_t lifetime = wasm_f32x4_add(wasm_v128_load(&s->lifetime[i]), wasm_f32x4_splat(delta_time));
+    v128_t live = wasm_v128_andnot(active_mask, wasm_f32x4_gt(lifetime, wasm_f32x4_splat(SPARK_LIFETIME)));
+    store_lanes(s->lifetime, i, lifetime, active_mask);
+
+    v128_t vx = wasm_v128_load(&s->vx[i]);
+    v128_t vy = wasm_v128_load(&s->vy[i]);
+    store_lanes(s->x, i, wasm_f32x4_add(wasm_v128_load(&s->x[i]), vx), live);
+    store_lanes(s->y, i, wasm_f32x4_add(wasm_v128_load(&s->y[i]), vy), live);
+    store_lanes(s->vy, i, wasm_f32x4_mul(wasm_f32x4_add(vy, wasm_f32x4_splat(f22_to_float(GRAVITY) * 0.5f)), drag), live);
+    store_lanes(s->vx, i, wasm_f32x4_mul(vx, drag), live);
+
+    v128_t fade = wasm_f32x4_sub(wasm_f32x4_splat(1.0f), wasm_f32x4_div(lifetime, wasm_f32x4_splat(SPARK_LIFETIME)));
+    int32_t alpha[4];
+    wasm_v128_store(alpha, wasm_i32x4_trunc_sat_f32x4(wasm_f32x4_mul(wasm_f32x4_splat(255.0f), fade)));
+    int live_bits = wasm_i32x4_bitmask(live);
+    for (int k = 0; k < 4; k++) {
+        if (live_bits & (1 << k)) s->a[i + k] = (uint8_t)alpha[k];
+        else if (active & (1 << k)) s->active[i + k] = false;
+    }
+}
+#endif
+
+static void update_debris_range(void* arg, int begin, int end) {
+    ExplosionJob* job = (ExplosionJob*)arg;
+    DebrisSet* debris = &job->system->debris;
+    int i = begin;
+
+    #ifdef __wasm_simd128__
+    for (; i + 4 <= end; i += 4) {
+        update_debris_x4(debris, i, job->delta_time);
+    }
+    #endif
+    for (; i < end; i++) {
+        if (!debris->active[i]) continue;
+        update_debris(debris, i, job->delta_time);
+    }
+}
+
+static void update_spark_range(void* arg, int begin, int end) {
+    ExplosionJob* job = (ExplosionJob*)arg;
+    SparkSet* sparks = &job->system->sparks;
+    int i = begin;
+
+    #ifdef __wasm_simd128__
+    for (; i + 4 <= end; i += 4) {
+        update_sparks_x4(sparks, i, job->delta_time);
+    }
+    #endif
+    for (; i < end; i++) {
+        if (!sparks->active[i]) continue;
+        update_spark(sparks, i, job->delta_time);
+    }
+}
+
+void explosion_update(ExplosionSystem* system, JobSystem* jobs, float delta_time) {
     if (!system->active) return;
+    Rng* rng = &system->rng;
     
     system->time += delta_time;
     if (system->time >= EXPLOSION_DURATION) {
@@ -129,57 +285,17 @@ void explosion_update(ExplosionSystem* system, float delta_time) {
         return;
     }
     
-    const float DRAG = 0.99f;
-    
-    // Update debris
-    for (int i = 0; i < MAX_DEBRIS; i++) {
-        Debris* d = &system->debris[i];
-        if (!d->active) continue;
-        
-        d->lifetime += delta_time;
-        if (d->lifetime > EXPLOSION_DURATION) {
-            d->active = false;
-            continue;
-        }
-        
-        // Update position
-        d->x += d->vx;
-        d->y += d->vy;
-        
-        // Apply gravity and drag
-        d->vy += f22_to_float(GRAVITY);
-        d->vx *= DRAG;
-        d->vy *= DRAG;
-        
-        // Update rotation
-        d->rotation += d->rot_speed * delta_time;
-        d->rot_speed *= 0.98f;  // slow rotation over time
-    }
+    // Integrate debris and sparks on the workers
+    ExplosionJob job = { system, delta_time };
+    jobs_parallel_for(jobs, MAX_DEBRIS, EXPLOSION_GRAIN, update_debris_range, &job);
+    jobs_parallel_for(jobs, MAX_SPARKS, EXPLOSION_GRAIN, update_spark_range, &job);
     
-    // Update sparks
+    // Occasionally spawn new sparks; writes random slots, so stays serial
+    SparkSet* sparks = &system->sparks;
     for (int i = 0; i < MAX_SPARKS; i++) {
-        Spark* s = &system->sparks[i];
-        if (!s->active) continue;
-        
-        s->lifetime += delta_time;
-        if (s->lifetime > 0.5f) {  // sparks are shorter-lived
-            s->active = false;
-            continue;
-        }
-        
-        s->x += s->vx;
-        s->y += s->vy;
-        s->vy += f22_to_float(GRAVITY) * 0.5f;  // lighter gravity for sparks
-        s->vx *= DRAG;
-        s->vy *= DRAG;
-        
-        // Fade out
-        float fade = 1.0f - (s->lifetime / 0.5f);
-        s->a = (uint8_t)(255.0f * fade);
-        
-        // Occasionally spawn new sparks
-        if (((float)rand() / (float)RAND_MAX) < 0.1f) {
-            create_spark(&system->sparks[rand() % MAX_SPARKS], s->x, s->y, s->vx * 0.5f);
+        if (!sparks->active[i]) continue;
+        if (rng_float(rng) < 0.1f) {
+            create_spark(sparks, rng_range(rng, MAX_SPARKS), rng, sparks->x[i], sparks->y[i], sparks->vx[i] * 0.5f);
         }
     }
 }
@@ -193,24 +309,46 @@ ScreenPos _world_to_screen(F22 world_x, F22 world_y, F22 camera_y_offset) {
 }
 
 
-void explosion_render(const ExplosionSystem* system, SDL_Renderer* renderer, F22 camera_y_offset) {
+#define EXPLOSION_MAX_PIECES (MAX_SPARKS > MAX_DEBRIS ? MAX_SPARKS : MAX_DEBRIS)
+
+// _world_to_screen for n pieces at once. The positions take the same trip
+// through F22, but as batches the SIMD build converts four at a time.
+static void explosion_to_screen(const float* x, const float* y, int n, F22 camera_y_offset, ScreenPos* out) {
+    F22 fixed_x[EXPLOSION_MAX_PIECES], fixed_y[EXPLOSION_MAX_PIECES];
+    float world_x[EXPLOSION_MAX_PIECES], world_y[EXPLOSION_MAX_PIECES];
+    f22_from_float_n(fixed_x, x, n);
+    f22_from_float_n(fixed_y, y, n);
+    f22_to_float_n(world_x, fixed_x, n);
+    f22_to_float_n(world_y, fixed_y, n);
+
+    float camera = f22_to_float(camera_y_offset);
+    for (int i = 0; i < n; i++) {
+        out[i].x = (int)(world_x[i] * WORLD_TO_SCREEN_SCALE);
+        out[i].y = (int)((world_y[i] - camera) * WORLD_TO_SCREEN_SCALE);
+    }
+}
+
+void explosion_render(const ExplosionSystem* system, const Canvas* canvas, F22 camera_y_offset, int spark_limit, CullStats* stats) {
     if (!system->active) return;
+    ScreenPos positions[EXPLOSION_MAX_PIECES];
     
     // First render debris
+    const DebrisSet* debris = &system->debris;
+    explosion_to_screen(debris->x, debris->y, MAX_DEBRIS, camera_y_offset, positions);
     for (int i = 0; i < MAX_DEBRIS; i++) {
-        const Debris* d = &system->debris[i];
-        if (!d->active) continue;
+        if (!debris->active[i]) continue;
+        const DebrisShape* d = &debris->shape[i];
+        ScreenPos pos = positions[i];
+
+        // Pieces keep flying until the explosion ends, mostly off screen
+        bool visible = cull_circle_visible(pos.x, pos.y, DEBRIS_EXTENT * d->scale);
+        cull_count(&stats->debris, visible);
+        if (!visible) continue;
         
         // Transform points
         SDL_Point transformed[8];
-        float cos_rot = cosf(d->rotation * M_PI / 180.0f);
-        float sin_rot = sinf(d->rotation * M_PI / 180.0f);
-        
-        ScreenPos pos = _world_to_screen(
-            f22_from_float(d->x), 
-            f22_from_float(d->y), 
-            camera_y_offset
-        );
+        float cos_rot = cosf(debris->rotation[i] * M_PI / 180.0f);
+        float sin_rot = sinf(debris->rotation[i] * M_PI / 180.0f);
         
         for (int j = 0; j < d->num_points; j++) {
             float px = d->points[j].x * d->scale;
@@ -221,28 +359,30 @@ void explosion_render(const ExplosionSystem* system, SDL_Renderer* renderer, F22
         }
         
         // Draw debris piece
-        SDL_SetRenderDrawColor(renderer, d->r, d->g, d->b, 255);
-        SDL_RenderDrawLines(renderer, transformed, d->num_points);
+        canvas_color(canvas, d->r, d->g, d->b, 255);
+        canvas_lines(canvas, transformed, d->num_points);
     }
     
     // Then render sparks on top
-    for (int i = 0; i < MAX_SPARKS; i++) {
-        const Spark* s = &system->sparks[i];
-        if (!s->active) continue;
-        
-        ScreenPos pos = _world_to_screen(
-            f22_from_float(s->x),
-            f22_from_float(s->y),
-            camera_y_offset
-        );
+    const SparkSet* sparks = &system->sparks;
+    explosion_to_screen(sparks->x, sparks->y, MAX_SPARKS, camera_y_offset, positions);
+    int sparks_drawn = 0;
+    for (int i = 0; i < MAX_SPARKS && sparks_drawn < spark_limit; i++) {
+        if (!sparks->active[i]) continue;
+        ScreenPos pos = positions[i];
+
+        bool visible = cull_circle_visible(pos.x, pos.y, 1.0f);
+        cull_count(&stats->sparks, visible);
+        if (!visible) continue;
+        sparks_drawn++;
         
         // Draw spark as small lines with glow effect
-        SDL_SetRenderDrawColor(renderer, s->r, s->g, s->b, s->a);
-        SDL_RenderDrawLine(renderer, 
+        canvas_color(canvas, sparks->r[i], sparks->g[i], sparks->b[i], sparks->a[i]);
+        canvas_line(canvas, 
             pos.x - 1, pos.y - 1,
             pos.x + 1, pos.y + 1
         );
-        SDL_RenderDrawLine(renderer,
+        canvas_line(canvas,
             pos.x - 1, pos.y + 1,
             pos.x + 1, pos.y - 1
         );
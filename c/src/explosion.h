@@ -8,46 +8,59 @@
 #include <math.h>
 #include "player.h"
 #include "config.h"
+#include "rng.h"
+#include "jobs.h"
+#include "cull.h"
 
 #define MAX_DEBRIS 48
 #define MAX_SPARKS 64
 #define EXPLOSION_DURATION 2.0f  // seconds
+#define DEBRIS_EXTENT 56.0f      // farthest shape point from a piece's origin, unscaled
 
+// Debris and sparks are structs of arrays: piece i is element i of every
+// array, so explosion_update can load four pieces per SIMD step
+// (src/explosion.c). What only the renderer reads stays together per piece.
 typedef struct {
     SDL_Point points[8];  // shape points for this debris piece
     int num_points;
-    float x, y;          // position
-    float vx, vy;        // velocity
-    float rotation;      // current rotation
-    float rot_speed;     // rotation speed
-    float scale;         // size scaling
-    bool active;
-    float lifetime;      // how long this piece has existed
-    uint8_t r, g, b;     // color values
-} Debris;
+    float scale;          // size scaling
+    uint8_t r, g, b;      // color values
+} DebrisShape;
 
 typedef struct {
-    float x, y;
-    float vx, vy;
-    float lifetime;
-    bool active;
-    uint8_t r, g, b, a;  // color with alpha
-} Spark;
+    float x[MAX_DEBRIS], y[MAX_DEBRIS];          // position
+    float vx[MAX_DEBRIS], vy[MAX_DEBRIS];        // velocity
+    float rotation[MAX_DEBRIS];                  // current rotation
+    float rot_speed[MAX_DEBRIS];                 // rotation speed
+    float lifetime[MAX_DEBRIS];                  // how long this piece has existed
+    bool active[MAX_DEBRIS];
+    DebrisShape shape[MAX_DEBRIS];
+} DebrisSet;
+
+typedef struct {
+    float x[MAX_SPARKS], y[MAX_SPARKS];
+    float vx[MAX_SPARKS], vy[MAX_SPARKS];
+    float lifetime[MAX_SPARKS];
+    bool active[MAX_SPARKS];
+    uint8_t r[MAX_SPARKS], g[MAX_SPARKS], b[MAX_SPARKS], a[MAX_SPARKS];  // color with alpha
+} SparkSet;
 
 typedef struct {
-    Debris debris[MAX_DEBRIS];
-    Spark sparks[MAX_SPARKS];
+    DebrisSet debris;
+    SparkSet sparks;
     bool active;
     float time;          // explosion timer
     F22 origin_x;        // where explosion started
     F22 origin_y;
+    Rng rng;
 } ExplosionSystem;
 
-ExplosionSystem explosion_init(void);
-void create_debris_piece(Debris* debris, const SDL_Point* shape, int num_points, float x, float y, float base_vx, float spread);
-void create_spark(Spark* spark, float x, float y, float base_vx);
+ExplosionSystem explosion_init(uint64_t seed);
+void create_debris_piece(DebrisSet* debris, int index, Rng* rng, const SDL_Point* shape, int num_points, float x, float y, float base_vx, float spread);
+void create_spark(SparkSet* sparks, int index, Rng* rng, float x, float y, float base_vx);
 void explosion_start(ExplosionSystem* system, const Player* player);
-void explosion_update(ExplosionSystem* system, float delta_time);
-void explosion_render(const ExplosionSystem* system, SDL_Renderer* renderer, F22 camera_y_offset);
+void explosion_update(ExplosionSystem* system, JobSystem* jobs, float delta_time);
+// Draws at most spark_limit of the sparks
+void explosion_render(const ExplosionSystem* system, const Canvas* canvas, F22 camera_y_offset, int spark_limit, CullStats* stats);
 
 #endif
\ No newline at end of file
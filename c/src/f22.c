@@ -34,4 +34,40 @@ F22 f22_div(F22 a, F22 b) {
     // Shift left first to maintain precision
     result.value = (int32_t)((((int64_t)a.value << F22_FRACTION_BITS) / b.value));
     return result;
-}
\ No newline at end of file
+}
+
+void f22_from_float_n(F22* out, const float* in, int n) {
+    int i = 0;
+    #ifdef __wasm_simd128__
+    for (; i + 4 <= n; i += 4) {
+        wasm_v128_store(&out[i], f22x4_from_float(wasm_v128_load(&in[i])));
+    }
+    #endif
+    for (; i < n; i++) {
+        out[i] = f22_from_float(in[i]);
+    }
+}
+
+void f22_to_float_n(float* out, const F22* in, int n) {
+    int i = 0;
+    #ifdef __wasm_simd128__
+    for (; i + 4 <= n; i += 4) {
+        wasm_v128_store(&out[i], f22x4_to_float(wasm_v128_load(&in[i])));
+    }
+    #endif
+    for (; i < n; i++) {
+        out[i] = f22_to_float(in[i]);
+    }
+}
+
+void f22_mul_n(F22* out, const F22* a, const F22* b, int n) {
+    int i = 0;
+    #ifdef __wasm_simd128__
+    for (; i + 4 <= n; i += 4) {
+        wasm_v128_store(&out[i], f22x4_mul(wasm_v128_load(&a[i]), wasm_v128_load(&b[i])));
+    }
+    #endif
+    for (; i < n; i++) {
+        out[i] = f22_mul(a[i], b[i]);
+    }
+}
@@ -23,4 +23,38 @@ F22 f22_sub(F22 a, F22 b);
 F22 f22_mul(F22 a, F22 b);
 F22 f22_div(F22 a, F22 b);
 
+// Batch forms of the above over n values
+void f22_from_float_n(F22* out, const float* in, int n);
+void f22_to_float_n(float* out, const F22* in, int n);
+void f22_mul_n(F22* out, const F22* a, const F22* b, int n);
+
+#ifdef __wasm_simd128__
+#include <wasm_simd128.h>
+
+// Four F22 values per v128 (as i32x4) for the SIMD web build; each lane gives
+// exactly what the scalar function above would
+static inline v128_t f22x4_from_float(v128_t a) {
+    return wasm_i32x4_trunc_sat_f32x4(wasm_f32x4_mul(a, wasm_f32x4_splat((float)F22_SCALE)));
+}
+
+static inline v128_t f22x4_add(v128_t a, v128_t b) {
+    return wasm_i32x4_add(a, b);
+}
+
+static inline v128_t f22x4_sub(v128_t a, v128_t b) {
+    return wasm_i32x4_sub(a, b);
+}
+
+static inline v128_t f22x4_mul(v128_t a, v128_t b) {
+    // 64-bit products as in f22_mul, then the low word of each shifted product
+    v128_t lo = wasm_i64x2_shr(wasm_i64x2_extmul_low_i32x4(a, b), F22_FRACTION_BITS);
+    v128_t hi = wasm_i64x2_shr(wasm_i64x2_extmul_high_i32x4(a, b), F22_FRACTION_BITS);
+    return wasm_i32x4_shuffle(lo, hi, 0, 2, 4, 6);
+}
+
+static inline v128_t f22x4_to_float(v128_t a) {
+    return wasm_f32x4_mul(wasm_f32x4_convert_i32x4(a), wasm_f32x4_splat(1.0f / F22_SCALE));
+}
+#endif
+
 #endif // F22_H
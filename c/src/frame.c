@@ -0,0 +1,86 @@
+#include "frame.h"
+#include <string.h>
+
+// Anything that moved further than this in one tick was respawned, not moved
+#define FRAME_TELEPORT_DISTANCE 100.0f
+
+void frame_capture(RenderFrame* frame, const GameState* state, bool thrust_active) {
+    frame->state = state->state;
+    frame->camera_y_offset = state->camera_y_offset;
+    frame->player = state->player;
+    memcpy(frame->wave, state->wave.points, sizeof(frame->wave));
+    frame->asteroid_system = state->asteroid_system;
+    frame->explosion = state->explosion;
+    frame->score = state->scoring.score;
+    frame->precision = state->scoring.current_precision;
+    frame->thrust_active = thrust_active;
+    frame->game_over = state->state == GAME_STATE_OVER &&
+                       state->explosion.time >= EXPLOSION_DURATION;
+}
+
+static inline float lerpf(float a, float b, float t) {
+    return a + (b - a) * t;
+}
+
+static inline F22 lerp_f22(F22 a, F22 b, float t) {
+    F22 result = { a.value + (int32_t)((b.value - a.value) * t) };
+    return result;
+}
+
+// Asteroid rotations wrap at 360, so blend along the short way round
+static inline float lerp_angle(float a, float b, float t) {
+    float diff = b - a;
+    if (diff > 180.0f) diff -= 360.0f;
+    else if (diff < -180.0f) diff += 360.0f;
+    return a + diff * t;
+}
+
+static inline bool teleported(float a, float b) {
+    return fabsf(b - a) > FRAME_TELEPORT_DISTANCE;
+}
+
+void frame_interpolate(RenderFrame* out, const RenderFrame* prev, const RenderFrame* curr, float alpha) {
+    *out = *curr;
+    if (alpha >= 1.0f) return;
+    if (alpha < 0.0f) alpha = 0.0f;
+
+    out->camera_y_offset = lerp_f22(prev->camera_y_offset, curr->camera_y_offset, alpha);
+    out->player.position.x = lerp_f22(prev->player.position.x, curr->player.position.x, alpha);
+    out->player.position.y = lerp_f22(prev->player.position.y, curr->player.position.y, alpha);
+    out->player.rotation = lerpf(prev->player.rotation, curr->player.rotation, alpha);
+
+    for (int i = 0; i < MAX_ASTEROIDS; i++) {
+        const Asteroid* a = &prev->asteroid_system.asteroids[i];
+        const Asteroid* b = &curr->asteroid_system.asteroids[i];
+        if (!a->active || !b->active) continue;
+        if (teleported(f22_to_float(a->x), f22_to_float(b->x)) ||
+            teleported(f22_to_float(a->y), f22_to_float(b->y))) continue;
+
+        Asteroid* o = &out->asteroid_system.asteroids[i];
+        o->x = lerp_f22(a->x, b->x, alpha);
+        o->y = lerp_f22(a->y, b->y, alpha);
+        o->rotation = lerp_angle(a->rotation, b->rotation, alpha);
+    }
+
+    if (!prev->explosion.active || !curr->explosion.active) return;
+    const DebrisSet* da = &prev->explosion.debris;
+    const DebrisSet* db = &curr->explosion.debris;
+    DebrisSet* dout = &out->explosion.debris;
+    for (int i = 0; i < MAX_DEBRIS; i++) {
+        if (!da->active[i] || !db->active[i] || db->lifetime[i] < da->lifetime[i]) continue;
+
+        dout->x[i] = lerpf(da->x[i], db->x[i], alpha);
+        dout->y[i] = lerpf(da->y[i], db->y[i], alpha);
+        dout->rotation[i] = lerpf(da->rotation[i], db->rotation[i], alpha);
+    }
+    const SparkSet* sa = &prev->explosion.sparks;
+    const SparkSet* sb = &curr->explosion.sparks;
+    SparkSet* sout = &out->explosion.sparks;
+    for (int i = 0; i < MAX_SPARKS; i++) {
+        // A respawned spark restarts its lifetime
+        if (!sa->active[i] || !sb->active[i] || sb->lifetime[i] < sa->lifetime[i]) continue;
+
+        sout->x[i] = lerpf(sa->x[i], sb->x[i], alpha);
+        sout->y[i] = lerpf(sa->y[i], sb->y[i], alpha);
+    }
+}
@@ -0,0 +1,29 @@
+#ifndef FRAME_H
+#define FRAME_H
+
+#include "game_state.h"
+
+// Immutable copy of everything the renderer reads from one simulation tick.
+// Only the visible part of the wave is kept.
+typedef struct {
+    GameStateEnum state;
+    F22 camera_y_offset;
+    Player player;
+    WavePoint wave[WINDOW_WIDTH];
+    AsteroidSystem asteroid_system;
+    ExplosionSystem explosion;
+    float score;
+    float precision;        // scoring.current_precision
+    bool thrust_active;
+    bool game_over;         // explosion has finished playing
+    uint32_t tick;
+    uint64_t timestamp;     // scheduled performance-counter time of this tick
+} RenderFrame;
+
+void frame_capture(RenderFrame* frame, const GameState* state, bool thrust_active);
+
+// Blends positions and rotations from prev towards curr (alpha in [0, 1]).
+// Everything discrete (state, wave, flags, shapes) is taken from curr.
+void frame_interpolate(RenderFrame* out, const RenderFrame* prev, const RenderFrame* curr, float alpha);
+
+#endif // FRAME_H
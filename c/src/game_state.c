@@ -83,7 +83,6 @@ void player_update(Player* player, const GameState* state, bool thrust, float de
 
     // Normalize the distance (0 to 1 scale)
     float normalized_distance = y_distance / WINDOW_HEIGHT;
-    printf("NORMALIZED DISTANCE AND Y_DISTANCE %f, %f: ", normalized_distance, y_distance);
 
     float screen_mid = WINDOW_WIDTH / 2.0f;
     float player_x = f22_to_float(player->position.x);
@@ -166,7 +165,7 @@ ScreenPos obstacle_get_screen_position(const Obstacle* obstacle) {
     return pos;
 }
 
-GameState game_state_init(void) {
+GameState game_state_create(uint64_t seed) {
     GameState state = {
         .state = GAME_STATE_WAITING,
         .player = player_init(),
@@ -174,11 +173,11 @@ GameState game_state_init(void) {
         .score = 0,
         .camera_y_offset = f22_from_float(0.0f),
         .target_y_offset = f22_from_float(0.0f),
-        .wave = wave_init(),
-        .asteroid_system = asteroid_system_init(),
-        .explosion = explosion_init(),
-        .smoke_system = smoke_system_init(),
-        .sound_system = sound_system_create(),
+        .wave = wave_init(seed),
+        .asteroid_system = asteroid_system_init(seed),
+        .explosion = explosion_init(seed),
+        .smoke_system = smoke_system_init(seed),
+        .sound_system = sound_system_create(seed),
         // .missile_system = missile_system_init(),
         .scoring = (ScoringSystem){
             .score = 0,
@@ -187,10 +186,6 @@ GameState game_state_init(void) {
         }
     };
 
-    set_sound_system(&state.sound_system);
-    sound_system_init(&state.sound_system);
-    sound_system_start_engine(&state.sound_system);
-
     // Initialize obstacles
     for (int i = 0; i < MAX_OBSTACLES; i++) {
         state.obstacles[i] = obstacle_init();
@@ -199,13 +194,24 @@ GameState game_state_init(void) {
     return state;
 }
 
+GameState game_state_init(uint64_t seed, Loader* loader) {
+    GameState state = game_state_create(seed);
+
+    set_sound_system(&state.sound_system);
+    sound_system_init(&state.sound_system, loader);
+    sound_system_start_engine(&state.sound_system);
+
+    return state;
+}
+
 void game_state_start(GameState* state) {
     state->state = GAME_STATE_PLAYING;
     state->score = 0;
     
-    printf("GAME HAS BEGUN LMFAO");
     sound_system_stop_engine(&state->sound_system);
-    play_random();
+    if (state->sound_system.initialized) {
+        play_random();
+    }
     // Reset player position to middle
     // state->player.position.x = f22_from_float(WINDOW_WIDTH / 2);
     // state->player.position.y = f22_from_float(WINDOW_HEIGHT / 2);
@@ -265,7 +271,7 @@ void game_state_update(GameState* state, bool thrust_active, float delta_time) {
     // Update wave first
     ScreenPos player_pos = player_get_screen_position(&state->player, state->camera_y_offset);
     wave_update(&state->wave, player_pos.y, state->state, delta_time);
-    explosion_update(&state->explosion, delta_time);
+    explosion_update(&state->explosion, state->jobs, delta_time);
     if (state->state == GAME_STATE_OVER) return;
     asteroid_system_update(&state->asteroid_system, &state->wave);
 
@@ -278,12 +284,6 @@ void game_state_update(GameState* state, bool thrust_active, float delta_time) {
     update_camera(state);
     update_scoring(state);
 
-    #ifdef __EMSCRIPTEN__
-        EM_ASM({
-            Module.updateScore($0);
-        }, (int)state->scoring.score);
-    #endif
-
     // Note: Obstacle spawning commented out like in original
     // Update active obstacles
     for (int i = 0; i < MAX_OBSTACLES; i++) {
@@ -10,6 +10,8 @@
 #include "explosion.h"
 #include "sound.h"
 #include "smoke.h"
+#include "jobs.h"
+#include "loader.h"
 
 // Obstacle struct
 typedef struct {
@@ -33,6 +35,7 @@ typedef struct {
     SmokeSystem smoke_system;
     SoundSystem sound_system;
     ScoringSystem scoring;
+    JobSystem* jobs;  // optional worker pool for particle updates; NULL runs inline
 } GameState;
 
 // Player functions
@@ -47,7 +50,8 @@ void obstacle_update(Obstacle* obstacle);
 ScreenPos obstacle_get_screen_position(const Obstacle* obstacle);
 
 // Game state functions
-GameState game_state_init(void);
+GameState game_state_create(uint64_t seed);  // simulation only, no audio device
+GameState game_state_init(uint64_t seed, Loader* loader);  // queues asset decoding on loader
 void game_state_start(GameState* state);
 void game_state_handle_click(GameState* state, int x, int y);
 void game_state_update(GameState* state, bool thrust_active, float delta_time);
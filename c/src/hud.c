@@ -0,0 +1,247 @@
+#include "hud.h"
+#include "pack.h"
+#include <SDL_ttf.h>
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+#define HUD_MARGIN 16
+#define HUD_FPS_WINDOW 0.5   // seconds
+
+static const SDL_Color HUD_WHITE = { 255, 255, 255, 255 };
+static const SDL_Color HUD_DIM = { 160, 160, 160, 255 };
+
+void hud_init(Hud* hud) {
+    memset(hud, 0, sizeof(*hud));
+    hud->show_fps = true;
+
+    // Two triangles per quad, the same pattern for every quad
+    for (int quad = 0; quad < HUD_TEXT_COUNT * HUD_MAX_TEXT; quad++) {
+        int* index = &hud->indices[quad * 6];
+        int base = quad * 4;
+        index[0] = base;
+        index[1] = base + 1;
+        index[2] = base + 2;
+        index[3] = base + 2;
+        index[4] = base + 3;
+        index[5] = base;
+    }
+
+    hud->texts[HUD_SCORE] = (HudText){
+        .x = WINDOW_WIDTH - HUD_MARGIN, .y = HUD_MARGIN,
+        .align = HUD_ALIGN_RIGHT, .color = HUD_WHITE
+    };
+    hud->texts[HUD_PRECISION] = (HudText){
+        .x = WINDOW_WIDTH - HUD_MARGIN, .y = HUD_MARGIN + HUD_FONT_SIZE,
+        .align = HUD_ALIGN_RIGHT, .color = HUD_DIM
+    };
+    hud->texts[HUD_FPS] = (HudText){
+        .x = HUD_MARGIN, .y = HUD_MARGIN,
+        .align = HUD_ALIGN_LEFT, .color = HUD_DIM
+    };
+    hud->texts[HUD_STATUS] = (HudText){
+        .x = WINDOW_WIDTH / 2, .y = WINDOW_HEIGHT / 2 + HUD_FONT_SIZE,
+        .align = HUD_ALIGN_CENTER, .color = HUD_WHITE
+    };
+}
+
+void hud_cleanup(Hud* hud) {
+    if (hud->atlas) {
+        SDL_DestroyTexture(hud->atlas);
+        hud->atlas = NULL;
+    }
+}
+
+// Rasterizes every glyph once and packs them into rows of the atlas
+static bool hud_bake(Hud* hud, SDL_Renderer* renderer) {
+    SDL_RWops* rw = pack_open_rw(HUD_FONT);
+    if (!rw) {
+        printf("HUD font %s not available\n", HUD_FONT);
+        return false;
+    }
+    if (TTF_Init() == -1) {
+        printf("SDL_ttf could not initialize! Error: %s\n", TTF_GetError());
+        SDL_RWclose(rw);
+        return false;
+    }
+    TTF_Font* font = TTF_OpenFontRW(rw, 1, HUD_FONT_SIZE);
+    if (!font) {
+        printf("Failed to open %s: %s\n", HUD_FONT, TTF_GetError());
+        TTF_Quit();
+        return false;
+    }
+
+    SDL_Surface* glyphs[HUD_GLYPH_COUNT];
+    int x = 0, y = 0, row_height = 0;
+    for (int i = 0; i < HUD_GLYPH_COUNT; i++) {
+        HudGlyph* glyph = &hud->glyphs[i];
+        uint16_t ch = (uint16_t)(HUD_FIRST_GLYPH + i);
+        int minx, maxx, miny, maxy;
+        if (TTF_GlyphMetrics(font, ch, &minx, &maxx, &miny, &maxy, &glyph->advance) != 0) {
+            glyph->advance = 0;
+        }
+
+        glyphs[i] = ch == ' ' ? NULL : TTF_RenderGlyph_Blended(font, ch, HUD_WHITE);
+        if (!glyphs[i]) continue;
+
+        if (x + glyphs[i]->w > HUD_ATLAS_WIDTH) {
+            x = 0;
+            y += row_height + 1;
+            row_height = 0;
+        }
+        glyph->src = (SDL_Rect){ x, y, glyphs[i]->w, glyphs[i]->h };
+        x += glyphs[i]->w + 1;   // 1 px gutter against bleeding when scaled
+        if (glyphs[i]->h > row_height) row_height = glyphs[i]->h;
+    }
+    hud->atlas_w = HUD_ATLAS_WIDTH;
+    hud->atlas_h = y + row_height;
+    TTF_CloseFont(font);
+    TTF_Quit();
+
+    SDL_Surface* atlas = SDL_CreateRGBSurfaceWithFormat(0, hud->atlas_w, hud->atlas_h, 32, SDL_PIXELFORMAT_RGBA32);
+    for (int i = 0; i < HUD_GLYPH_COUNT; i++) {
+        if (!glyphs[i]) continue;
+        if (atlas) {
+            // Copy the glyph's alpha as is rather than blending it onto black
+            SDL_SetSurfaceBlendMode(glyphs[i], SDL_BLENDMODE_NONE);
+            SDL_BlitSurface(glyphs[i], NULL, atlas, &hud->glyphs[i].src);
+        }
+        SDL_FreeSurface(glyphs[i]);
+    }
+    if (!atlas) {
+        printf("Failed to create the HUD atlas: %s\n", SDL_GetError());
+        return false;
+    }
+
+    hud->atlas = SDL_CreateTextureFromSurface(renderer, atlas);
+    SDL_FreeSurface(atlas);
+    if (!hud->atlas) {
+        printf("Failed to upload the HUD atlas: %s\n", SDL_GetError());
+        return false;
+    }
+    SDL_SetTextureBlendMode(hud->atlas, SDL_BLENDMODE_BLEND);
+    printf("HUD atlas %dx%d\n", hud->atlas_w, hud->atlas_h);
+    return true;
+}
+
+// Bakes the atlas the first time the font is resident, starting the
+// download if it is still remote
+static bool hud_ready(Hud* hud, SDL_Renderer* renderer) {
+    if (hud->atlas) return true;
+    if (hud->failed) return false;
+
+    switch (pack_status(HUD_FONT)) {
+        case PACK_RESIDENT:
+            hud->failed = !hud_bake(hud, renderer);
+            return !hud->failed;
+        case PACK_REMOTE:
+            pack_fetch(HUD_FONT);
+            return false;
+        case PACK_FETCHING:
+            return false;
+        default:
+            printf("HUD font %s missing, drawing no HUD\n", HUD_FONT);
+            hud->failed = true;
+            return false;
+    }
+}
+
+static const HudGlyph* hud_glyph(const Hud* hud, char c) {
+    int index = (unsigned char)c - HUD_FIRST_GLYPH;
+    if (index < 0 || index >= HUD_GLYPH_COUNT) index = '?' - HUD_FIRST_GLYPH;
+    return &hud->glyphs[index];
+}
+
+static void hud_layout(const Hud* hud, HudText* text) {
+    int width = 0;
+    for (const char* c = text->text; *c; c++) {
+        width += hud_glyph(hud, *c)->advance;
+    }
+
+    int x = text->x;
+    if (text->align == HUD_ALIGN_RIGHT) x -= width;
+    if (text->align == HUD_ALIGN_CENTER) x -= width / 2;
+
+    float inv_w = 1.0f / hud->atlas_w;
+    float inv_h = 1.0f / hud->atlas_h;
+    text->num_quads = 0;
+    for (const char* c = text->text; *c; c++) {
+        const HudGlyph* glyph = hud_glyph(hud, *c);
+        if (glyph->src.w > 0) {
+            float x0 = (float)x, y0 = (float)text->y;
+            float x1 = x0 + glyph->src.w, y1 = y0 + glyph->src.h;
+            float u0 = glyph->src.x * inv_w, v0 = glyph->src.y * inv_h;
+            float u1 = (glyph->src.x + glyph->src.w) * inv_w;
+            float v1 = (glyph->src.y + glyph->src.h) * inv_h;
+
+            SDL_Vertex* v = &text->vertices[text->num_quads++ * 4];
+            v[0] = (SDL_Vertex){ { x0, y0 }, text->color, { u0, v0 } };
+            v[1] = (SDL_Vertex){ { x1, y0 }, text->color, { u1, v0 } };
+            v[2] = (SDL_Vertex){ { x1, y1 }, text->color, { u1, v1 } };
+            v[3] = (SDL_Vertex){ { x0, y1 }, text->color, { u0, v1 } };
+        }
+        x += glyph->advance;
+    }
+}
+
+// Shows id with the given text; the quads are rebuilt only if it changed
+static void hud_set_text(Hud* hud, HudTextId id, const char* text) {
+    HudText* entry = &hud->texts[id];
+    entry->visible = true;
+    if (strncmp(entry->text, text, HUD_MAX_TEXT) == 0 && entry->num_quads > 0) return;
+
+    snprintf(entry->text, sizeof(entry->text), "%s", text);
+    hud_layout(hud, entry);
+}
+
+static void hud_count_frame(Hud* hud) {
+    uint64_t now = SDL_GetPerformanceCounter();
+    if (hud->fps_window_start == 0) hud->fps_window_start = now;
+    hud->fps_frames++;
+
+    double elapsed = (double)(now - hud->fps_window_start) / SDL_GetPerformanceFrequency();
+    if (elapsed >= HUD_FPS_WINDOW) {
+        hud->fps = (int)lround(hud->fps_frames / elapsed);
+        hud->fps_frames = 0;
+        hud->fps_window_start = now;
+    }
+}
+
+void hud_draw(Hud* hud, SDL_Renderer* renderer, const RenderFrame* frame) {
+    hud_count_frame(hud);
+    if (!hud_ready(hud, renderer)) return;
+
+    for (int i = 0; i < HUD_TEXT_COUNT; i++) {
+        hud->texts[i].visible = false;
+    }
+
+    char text[HUD_MAX_TEXT + 1];
+    snprintf(text, sizeof(text), "SCORE %u", (unsigned)frame->score);
+    hud_set_text(hud, HUD_SCORE, text);
+
+    if (frame->state == GAME_STATE_PLAYING) {
+        float precision = frame->precision > 0.0f ? frame->precision : 0.0f;
+        snprintf(text, sizeof(text), "PRECISION %3d%%", (int)lroundf(precision * 100.0f));
+        hud_set_text(hud, HUD_PRECISION, text);
+    }
+
+    if (hud->show_fps && hud->fps > 0) {
+        snprintf(text, sizeof(text), "%d FPS", hud->fps);
+        hud_set_text(hud, HUD_FPS, text);
+    }
+
+    if (frame->state == GAME_STATE_WAITING) {
+        hud_set_text(hud, HUD_STATUS, "CLICK TO START");
+    }
+
+    int quads = 0;
+    for (int i = 0; i < HUD_TEXT_COUNT; i++) {
+        const HudText* entry = &hud->texts[i];
+        if (!entry->visible || entry->num_quads == 0) continue;
+        memcpy(&hud->batch[quads * 4], entry->vertices, sizeof(SDL_Vertex) * 4 * (size_t)entry->num_quads);
+        quads += entry->num_quads;
+    }
+    if (quads > 0) {
+        SDL_RenderGeometry(renderer, hud->atlas, hud->batch, quads * 4, hud->indices, quads * 6);
+    }
+}
@@ -0,0 +1,71 @@
+#ifndef HUD_H
+#define HUD_H
+
+#include <SDL.h>
+#include <stdbool.h>
+#include "frame.h"
+
+#define HUD_FONT "vt323.ttf"
+#define HUD_FONT_SIZE 32
+#define HUD_FIRST_GLYPH 32      // printable ASCII only
+#define HUD_GLYPH_COUNT 95
+#define HUD_ATLAS_WIDTH 512
+#define HUD_MAX_TEXT 24         // characters per string
+
+typedef enum {
+    HUD_SCORE,
+    HUD_PRECISION,
+    HUD_FPS,
+    HUD_STATUS,
+    HUD_TEXT_COUNT
+} HudTextId;
+
+typedef enum {
+    HUD_ALIGN_LEFT,
+    HUD_ALIGN_CENTER,
+    HUD_ALIGN_RIGHT
+} HudAlign;
+
+typedef struct {
+    SDL_Rect src;       // in the atlas; empty for blanks
+    int advance;
+} HudGlyph;
+
+// One HUD string and its quads, laid out again only when the text changes
+typedef struct {
+    char text[HUD_MAX_TEXT + 1];
+    int x, y;           // anchor, top edge
+    HudAlign align;
+    SDL_Color color;
+    bool visible;
+    int num_quads;
+    SDL_Vertex vertices[HUD_MAX_TEXT * 4];
+} HudText;
+
+// Text overlay drawn from a glyph atlas. The font is rasterized once into a
+// single texture, and every visible string goes out in one
+// SDL_RenderGeometry call. On the web the font is an external pack entry;
+// nothing is drawn until it has downloaded.
+typedef struct {
+    SDL_Texture* atlas;         // NULL until baked
+    bool failed;                // font missing or unreadable; stop trying
+    int atlas_w, atlas_h;
+    HudGlyph glyphs[HUD_GLYPH_COUNT];
+    HudText texts[HUD_TEXT_COUNT];
+    SDL_Vertex batch[HUD_TEXT_COUNT * HUD_MAX_TEXT * 4];
+    int indices[HUD_TEXT_COUNT * HUD_MAX_TEXT * 6];
+
+    // FPS, counted over half-second windows
+    uint64_t fps_window_start;
+    int fps_frames;
+    int fps;
+    bool show_fps;              // off for reproducible headless frames
+} Hud;
+
+void hud_init(Hud* hud);
+void hud_cleanup(Hud* hud);
+
+// Updates the strings from the frame and draws them
+void hud_draw(Hud* hud, SDL_Renderer* renderer, const RenderFrame* frame);
+
+#endif // HUD_H
@@ -0,0 +1,260 @@
+#include "jobs.h"
+#include <SDL.h>
+#include <stdbool.h>
+#include <stdio.h>
+
+#define MAX_JOB_WORKERS 64
+#define JOB_DEQUE_SIZE 256   // power of two; a full deque runs the task inline
+#define JOB_STEAL_ROUNDS 64  // failed steal sweeps before a worker sleeps
+#define JOB_HELP_ROUNDS 64   // failed sweeps before a waiting caller yields
+
+// A parallel_for call; finished when every item has been processed
+typedef struct {
+    SDL_atomic_t remaining;
+} JobGroup;
+
+// Half-open item range of one parallel_for. Ranges larger than `grain` are
+// split in half when run, and the other half becomes stealable.
+typedef struct {
+    JobRangeFunc fn;
+    void* ctx;
+    int begin;
+    int end;
+    int grain;
+    JobGroup* group;
+} Job;
+
+// Owner pushes/pops at the bottom (newest, smallest ranges, cache-warm),
+// thieves take from the top (oldest, largest ranges). A spinlock is enough
+// since the owner rarely contends with a thief on the same deque.
+typedef struct {
+    SDL_SpinLock lock;
+    int top;
+    int bottom;
+    Job jobs[JOB_DEQUE_SIZE];
+} JobDeque;
+
+typedef struct {
+    JobSystem* jobs;
+    int slot;
+} WorkerStart;
+
+struct JobSystem {
+    SDL_Thread* threads[MAX_JOB_WORKERS];
+    WorkerStart starts[MAX_JOB_WORKERS];
+    int num_workers;
+    int num_deques;           // fixed before any worker starts
+    // deques[0] is shared by every thread that is not a worker (main, sim)
+    JobDeque deques[MAX_JOB_WORKERS + 1];
+    SDL_TLSID worker_slot;    // deque index + 1 for worker threads
+    SDL_atomic_t queued;      // jobs sitting in any deque
+    SDL_atomic_t sleeping;
+    SDL_mutex* lock;
+    SDL_cond* wake;
+    SDL_atomic_t quit;
+};
+
+static bool deque_push(JobDeque* deque, const Job* job) {
+    bool pushed = false;
+    SDL_AtomicLock(&deque->lock);
+    if (deque->bottom - deque->top < JOB_DEQUE_SIZE) {
+        deque->jobs[deque->bottom & (JOB_DEQUE_SIZE - 1)] = *job;
+        deque->bottom++;
+        pushed = true;
+    }
+    SDL_AtomicUnlock(&deque->lock);
+    return pushed;
+}
+
+static bool deque_pop(JobDeque* deque, Job* job) {
+    bool popped = false;
+    SDL_AtomicLock(&deque->lock);
+    if (deque->bottom > deque->top) {
+        deque->bottom--;
+        *job = deque->jobs[deque->bottom & (JOB_DEQUE_SIZE - 1)];
+        popped = true;
+    }
+    SDL_AtomicUnlock(&deque->lock);
+    return popped;
+}
+
+static bool deque_steal(JobDeque* deque, Job* job) {
+    bool stolen = false;
+    SDL_AtomicLock(&deque->lock);
+    if (deque->bottom > deque->top) {
+        *job = deque->jobs[deque->top & (JOB_DEQUE_SIZE - 1)];
+        deque->top++;
+        stolen = true;
+    }
+    SDL_AtomicUnlock(&deque->lock);
+    return stolen;
+}
+
+static int current_slot(JobSystem* jobs) {
+    return (int)(intptr_t)SDL_TLSGet(jobs->worker_slot);
+}
+
+static void push_job(JobSystem* jobs, int slot, const Job* job) {
+    if (!deque_push(&jobs->deques[slot], job)) {
+        // Deque full: nobody else will see this range, so just run it here
+        job->fn(job->ctx, job->begin, job->end);
+        SDL_AtomicAdd(&job->group->remaining, -(job->end - job->begin));
+        return;
+    }
+    SDL_AtomicAdd(&jobs->queued, 1);
+    if (SDL_AtomicGet(&jobs->sleeping) > 0) {
+        SDL_LockMutex(jobs->lock);
+        SDL_CondSignal(jobs->wake);
+        SDL_UnlockMutex(jobs->lock);
+    }
+}
+
+static void run_job(JobSystem* jobs, int slot, Job job) {
+    // Lazy binary splitting: keep the left half, expose the right half to thieves
+    while (job.end - job.begin > job.grain) {
+        int mid = job.begin + (job.end - job.begin) / 2;
+        Job right = job;
+        right.begin = mid;
+        job.end = mid;
+        push_job(jobs, slot, &right);
+    }
+    job.fn(job.ctx, job.begin, job.end);
+    SDL_AtomicAdd(&job.group->remaining, -(job.end - job.begin));
+}
+
+static bool find_job(JobSystem* jobs, int slot, Job* job) {
+    if (deque_pop(&jobs->deques[slot], job)) {
+        SDL_AtomicAdd(&jobs->queued, -1);
+        return true;
+    }
+
+    int num_deques = jobs->num_deques;
+    for (int i = 1; i < num_deques; i++) {
+        int victim = (slot + i) % num_deques;
+        if (deque_steal(&jobs->deques[victim], job)) {
+            SDL_AtomicAdd(&jobs->queued, -1);
+            return true;
+        }
+    }
+    return false;
+}
+
+static int worker_main(void* arg) {
+    WorkerStart* start = (WorkerStart*)arg;
+    JobSystem* jobs = start->jobs;
+    int slot = start->slot;
+    SDL_TLSSet(jobs->worker_slot, (void*)(intptr_t)(slot + 1), NULL);
+
+    int idle_rounds = 0;
+    while (!SDL_AtomicGet(&jobs->quit)) {
+        Job job;
+        if (find_job(jobs, slot, &job)) {
+            run_job(jobs, slot, job);
+            idle_rounds = 0;
+            continue;
+        }
+        if (++idle_rounds < JOB_STEAL_ROUNDS) continue;
+
+        SDL_LockMutex(jobs->lock);
+        SDL_AtomicAdd(&jobs->sleeping, 1);
+        if (SDL_AtomicGet(&jobs->queued) == 0 && !SDL_AtomicGet(&jobs->quit)) {
+            SDL_CondWait(jobs->wake, jobs->lock);
+        }
+        SDL_AtomicAdd(&jobs->sleeping, -1);
+        SDL_UnlockMutex(jobs->lock);
+        idle_rounds = 0;
+    }
+    return 0;
+}
+
+JobSystem* jobs_create(int num_workers) {
+    if (num_workers < 0) num_workers = SDL_GetCPUCount() - 1;
+    if (num_workers > MAX_JOB_WORKERS) num_workers = MAX_JOB_WORKERS;
+    #if defined(__EMSCRIPTEN__) && !defined(__EMSCRIPTEN_PTHREADS__)
+    num_workers = 0;  // no threads in the single-threaded web build
+    #endif
+
+    JobSystem* jobs = SDL_calloc(1, sizeof(JobSystem));
+    if (!jobs) return NULL;
+
+    jobs->worker_slot = SDL_TLSCreate();
+    jobs->lock = SDL_CreateMutex();
+    jobs->wake = SDL_CreateCond();
+    jobs->num_deques = num_workers + 1;  // a worker that fails to start leaves an empty deque
+
+    for (int i = 0; i < num_workers; i++) {
+        WorkerStart* start = &jobs->starts[i];
+        start->jobs = jobs;
+        start->slot = i + 1;
+        jobs->threads[i] = SDL_CreateThread(worker_main, "f22_job", start);
+        if (!jobs->threads[i]) {
+            printf("Failed to start job worker %d: %s\n", i, SDL_GetError());
+            break;
+        }
+        jobs->num_workers++;
+    }
+    return jobs;
+}
+
+void jobs_destroy(JobSystem* jobs) {
+    if (!jobs) return;
+
+    SDL_LockMutex(jobs->lock);
+    SDL_AtomicSet(&jobs->quit, 1);
+    SDL_CondBroadcast(jobs->wake);
+    SDL_UnlockMutex(jobs->lock);
+
+    for (int i = 0; i < jobs->num_workers; i++) {
+        SDL_WaitThread(jobs->threads[i], NULL);
+    }
+    SDL_DestroyCond(jobs->wake);
+    SDL_DestroyMutex(jobs->lock);
+    SDL_free(jobs);
+}
+
+int jobs_worker_count(const JobSystem* jobs) {
+    return jobs ? jobs->num_workers : 0;
+}
+
+void jobs_parallel_for(JobSystem* jobs, int count, int grain, JobRangeFunc fn, void* ctx) {
+    if (count <= 0) return;
+    if (grain < 1) grain = 1;
+    if (!jobs || jobs->num_workers == 0 || count <= grain) {
+        fn(ctx, 0, count);
+        return;
+    }
+
+    // Non-worker callers share deque 0; workers (nested loops) use their own
+    int slot = current_slot(jobs);
+    if (slot > 0) slot--;
+
+    JobGroup group;
+    SDL_AtomicSet(&group.remaining, count);
+    Job job = {
+        .fn = fn,
+        .ctx = ctx,
+        .begin = 0,
+        .end = count,
+        .grain = grain,
+        .group = &group
+    };
+    run_job(jobs, slot, job);
+
+    // Help out (possibly with unrelated jobs) until our range is finished.
+    // Once nothing is left to steal the last ranges are running elsewhere;
+    // back off so two waiters on deque 0 don't hammer its lock meanwhile.
+    int idle_rounds = 0;
+    while (SDL_AtomicGet(&group.remaining) > 0) {
+        Job other;
+        if (find_job(jobs, slot, &other)) {
+            run_job(jobs, slot, other);
+            idle_rounds = 0;
+            continue;
+        }
+        if (++idle_rounds < JOB_HELP_ROUNDS) {
+            SDL_CpuPauseInstruction();
+        } else {
+            SDL_Delay(0);
+        }
+    }
+}
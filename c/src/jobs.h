@@ -0,0 +1,22 @@
+#ifndef JOBS_H
+#define JOBS_H
+
+// Small work-stealing thread pool for data-parallel loops over independent
+// entities. Built on SDL threads so it runs natively and with Emscripten
+// pthreads; the single-threaded web build gets zero workers and runs inline.
+typedef void (*JobRangeFunc)(void* ctx, int begin, int end);
+
+typedef struct JobSystem JobSystem;
+
+// num_workers < 0 uses one worker per core besides the calling thread
+JobSystem* jobs_create(int num_workers);
+void jobs_destroy(JobSystem* jobs);
+int jobs_worker_count(const JobSystem* jobs);
+
+// Calls fn over [0, count) in chunks of at most `grain` items and returns when
+// every chunk is done. Ranges are split in half on demand and idle workers
+// steal the larger halves. The calling thread works too (and may be called
+// from inside a job); a NULL pool or a range that fits in one chunk runs inline.
+void jobs_parallel_for(JobSystem* jobs, int count, int grain, JobRangeFunc fn, void* ctx);
+
+#endif // JOBS_H
@@ -0,0 +1,85 @@
+#include "loader.h"
+#include <SDL.h>
+#include <stdio.h>
+
+typedef struct {
+    const char* name;
+    LoaderFunc func;
+    void* ctx;
+} LoaderTask;
+
+struct Loader {
+    LoaderTask tasks[LOADER_MAX_TASKS];
+    int count;             // fixed once loader_start runs
+    int next;              // owned by whichever thread runs the tasks
+    SDL_atomic_t done;
+    SDL_atomic_t quit;
+    SDL_Thread* thread;
+    uint64_t start;
+};
+
+Loader* loader_create(void) {
+    return SDL_calloc(1, sizeof(Loader));
+}
+
+void loader_add(Loader* loader, const char* name, LoaderFunc func, void* ctx) {
+    if (loader->count >= LOADER_MAX_TASKS) {
+        printf("Loader full, loading %s now\n", name);
+        func(ctx);
+        return;
+    }
+    loader->tasks[loader->count++] = (LoaderTask){ name, func, ctx };
+}
+
+static void loader_run_next(Loader* loader) {
+    LoaderTask* task = &loader->tasks[loader->next++];
+    task->func(task->ctx);
+
+    if (loader->next == loader->count) {
+        uint64_t elapsed = SDL_GetPerformanceCounter() - loader->start;
+        printf("Loaded %d assets in %.1f ms\n", loader->count,
+               elapsed * 1000.0 / SDL_GetPerformanceFrequency());
+    }
+    SDL_AtomicAdd(&loader->done, 1);
+}
+
+static int loader_thread_main(void* arg) {
+    Loader* loader = (Loader*)arg;
+    while (loader->next < loader->count && !SDL_AtomicGet(&loader->quit)) {
+        loader_run_next(loader);
+    }
+    return 0;
+}
+
+void loader_start(Loader* loader) {
+    loader->start = SDL_GetPerformanceCounter();
+    if (loader->count == 0) return;
+
+    #if !defined(__EMSCRIPTEN__) || defined(__EMSCRIPTEN_PTHREADS__)
+    loader->thread = SDL_CreateThread(loader_thread_main, "f22_loader", loader);
+    if (!loader->thread) {
+        printf("Failed to start loader thread, loading from the main loop: %s\n", SDL_GetError());
+    }
+    #endif
+}
+
+void loader_poll(Loader* loader) {
+    if (loader->thread || loader->next >= loader->count) return;
+    loader_run_next(loader);
+}
+
+bool loader_progress(const Loader* loader, int* done, int* total) {
+    int finished = SDL_AtomicGet((SDL_atomic_t*)&loader->done);
+    if (done) *done = finished;
+    if (total) *total = loader->count;
+    return finished >= loader->count;
+}
+
+void loader_destroy(Loader* loader) {
+    if (!loader) return;
+    if (loader->thread) {
+        SDL_AtomicSet(&loader->quit, 1);
+        SDL_WaitThread(loader->thread, NULL);
+    }
+    SDL_free(loader);
+}
@@ -0,0 +1,27 @@
+#ifndef LOADER_H
+#define LOADER_H
+
+#include <stdbool.h>
+
+// Background asset loading, so the first frame never waits on decoding. Tasks
+// run in the order they were added on one loader thread; without threads
+// (single-threaded web build) loader_poll runs one task per call from the
+// main loop. Each task publishes its own result when it finishes.
+typedef void (*LoaderFunc)(void* ctx);
+
+#define LOADER_MAX_TASKS 16
+
+typedef struct Loader Loader;
+
+Loader* loader_create(void);
+void loader_destroy(Loader* loader);   // waits for the task in flight, drops the rest
+
+// Only before loader_start
+void loader_add(Loader* loader, const char* name, LoaderFunc func, void* ctx);
+void loader_start(Loader* loader);
+void loader_poll(Loader* loader);      // no-op while a loader thread is running
+
+// Tasks finished so far; true once all of them are
+bool loader_progress(const Loader* loader, int* done, int* total);
+
+#endif // LOADER_H
@@ -3,28 +3,57 @@
 #include "game_state.h"
 #include "renderer.h"
 #include "missile.h"
+#include "jobs.h"
+#include "sim.h"
+#include "pack.h"
+#include "loader.h"
+#include "ui_state.h"
+#include "pacer.h"
 #include <stdio.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
 #include <time.h>
 
 #ifdef __EMSCRIPTEN__
 #include <emscripten.h>
 #endif
 
-// Global state for emscripten main loop
+#define FRAME_REPORT_FRAMES 600   // print frame timing every 10 s at 60 fps
+
+// Frame timing as seen by f22_step
+typedef struct {
+    int frames;
+    double last_timestamp;     // ms, 0 before the first frame
+    double interval_total, interval_max;
+    double step_total, step_max;
+    CullStats cull;            // summed over the frames
+} FrameReport;
+
+// Global state for the main loop
 typedef struct {
     bool quit;
     bool thrust_active;
-    GameState game_state;
+    GameState game_state;      // owned by the simulation once it starts
     Renderer renderer;
-    uint32_t last_frame_time;  // Track frame timing
-    float delta_time;       
-    float accumulated_time;   // Time between frames in seconds
+    JobSystem* jobs;           // shared by simulation and render prep
+    SimThread* sim;
+    bool sim_threaded;         // false: main_loop steps the simulation itself
+    Loader* loader;            // sound effects decode while the game runs
+    uint64_t launch_time;      // performance counter at the top of main
+    bool first_frame_shown;
+    bool assets_reported;
+    RenderFrame frame;         // interpolated view being drawn
     float target_fps;          // Target frame rate
-    float frame_time;          // Target time per frame in ms
+    FramePacer pacer;          // native loop only; the page paces the web build
+    FrameReport report;
 } GameContext;
 
+// Lives outside main's stack: on the web main returns before the first frame
+static GameContext g_ctx;
+
 void handle_input(GameContext* ctx) {
-    if (ctx->game_state.state == GAME_STATE_OVER) return;
+    if (ctx->frame.state == GAME_STATE_OVER) return;
     SDL_Event event;
     while (SDL_PollEvent(&event)) {
         switch (event.type) {
@@ -32,20 +61,14 @@ void handle_input(GameContext* ctx) {
                 ctx->quit = true;
                 break;
             case SDL_MOUSEBUTTONDOWN:
-                game_state_handle_click(&ctx->game_state, event.button.x, event.button.y);
-                #ifdef __EMSCRIPTEN__
-                EM_ASM(
-                    Module.setGameState(1);
-                    console.log("GAME HAS BEGUN");
-                );
-                #endif
+                sim_click(ctx->sim);
                 break;
             case SDL_KEYDOWN:
                 switch (event.key.keysym.sym) {
                     case SDLK_SPACE:
                     case SDLK_UP:
                         ctx->thrust_active = true;
-                        sound_system_start_engine(&ctx->game_state.sound_system);
+                        sim_set_thrust(ctx->sim, true);
                         break;
                     // case SDLK_ESCAPE:
                     //     ctx->quit = true;
@@ -62,7 +85,7 @@ void handle_input(GameContext* ctx) {
                     case SDLK_SPACE:
                     case SDLK_UP:
                         ctx->thrust_active = false;
-                        sound_system_stop_engine(&ctx->game_state.sound_system);
+                        sim_set_thrust(ctx->sim, false);
                         break;
                 }
                 break;
@@ -70,50 +93,210 @@ void handle_input(GameContext* ctx) {
     }
 }
 
-void main_loop(void* arg) {
-    GameContext* ctx = (GameContext*)arg;
-    const float FIXED_TIME_STEP = 1.0f / 60.0f;
-    
-    uint32_t current_time = SDL_GetTicks();
-    float frame_time = (current_time - ctx->last_frame_time) / 1000.0f;
-    ctx->last_frame_time = current_time;
-    
-    if (frame_time > 0.25f) frame_time = 0.25f;
-    ctx->accumulated_time += frame_time;
-    
-    while (ctx->accumulated_time >= FIXED_TIME_STEP) {
-        handle_input(ctx);
-        game_state_update(&ctx->game_state, ctx->thrust_active, FIXED_TIME_STEP);
-        
-        // Check collisions - but now we KEEP rendering
-        if (game_state_check_collisions(&ctx->game_state)) {
-            #ifdef __EMSCRIPTEN__
-            // Don't cancel the loop immediately
-            if (ctx->game_state.explosion.time >= EXPLOSION_DURATION) {
-                emscripten_cancel_main_loop();
-                EM_ASM({
-                    Module.showGameOver($0);
-                }, (int)ctx->game_state.scoring.score);
-                return;
-            }
-            #else
-            if (ctx->game_state.explosion.time >= EXPLOSION_DURATION) {
-                ctx->quit = true;
-                printf("Game Over! Score: %u\n", ctx->game_state.score);
-                return;
-            }
-            #endif
+static double ms_since_launch(const GameContext* ctx) {
+    uint64_t elapsed = SDL_GetPerformanceCounter() - ctx->launch_time;
+    return elapsed * 1000.0 / SDL_GetPerformanceFrequency();
+}
+
+static void report_startup(GameContext* ctx) {
+    int done, total;
+    bool loaded = loader_progress(ctx->loader, &done, &total);
+    if (!ctx->first_frame_shown) {
+        ctx->first_frame_shown = true;
+        printf("First frame after %.1f ms (assets %d/%d)\n", ms_since_launch(ctx), done, total);
+    }
+    if (loaded && !ctx->assets_reported) {
+        ctx->assets_reported = true;
+        printf("All assets ready after %.1f ms\n", ms_since_launch(ctx));
+    }
+}
+
+static void main_loop(GameContext* ctx) {
+    handle_input(ctx);
+    if (!ctx->sim_threaded) {
+        sim_advance(ctx->sim);
+    }
+    sound_system_update();
+    loader_poll(ctx->loader);
+    if (!sim_render_frame(ctx->sim, &ctx->frame)) return;
+    ui_state_publish(&ctx->frame);
+
+    // The simulation stops once the explosion has finished playing; the page
+    // sees game_over in the UI state and shows the submit dialog
+    if (ctx->frame.game_over) {
+        ctx->quit = true;
+        #ifndef __EMSCRIPTEN__
+        printf("Game Over! Score: %u\n", (unsigned)ctx->frame.score);
+        #endif
+        return;
+    }
+
+    renderer_draw_frame(&ctx->renderer, &ctx->frame);
+    report_startup(ctx);
+}
+
+static void cull_add(CullCount* total, CullCount count) {
+    total->drawn += count.drawn;
+    total->culled += count.culled;
+}
+
+static void frame_report_add(FrameReport* report, double timestamp, double step_ms, const CullStats* cull,
+                             Capture* capture) {
+    if (report->last_timestamp > 0.0) {
+        double interval = timestamp - report->last_timestamp;
+        report->interval_total += interval;
+        if (interval > report->interval_max) report->interval_max = interval;
+    }
+    report->last_timestamp = timestamp;
+    report->step_total += step_ms;
+    if (step_ms > report->step_max) report->step_max = step_ms;
+    cull_add(&report->cull.asteroids, cull->asteroids);
+    cull_add(&report->cull.wave_segments, cull->wave_segments);
+    cull_add(&report->cull.debris, cull->debris);
+    cull_add(&report->cull.sparks, cull->sparks);
+
+    if (++report->frames < FRAME_REPORT_FRAMES) return;
+    printf("Frame interval %.2f ms avg, %.2f max; step %.2f ms avg, %.2f max\n",
+           report->interval_total / (report->frames - 1), report->interval_max,
+           report->step_total / report->frames, report->step_max);
+    const CullStats* c = &report->cull;
+    double n = report->frames;
+    printf("Culled per frame (drawn/culled): asteroids %.1f/%.1f, wave %.0f/%.0f, debris %.1f/%.1f, sparks %.1f/%.1f\n",
+           c->asteroids.drawn / n, c->asteroids.culled / n,
+           c->wave_segments.drawn / n, c->wave_segments.culled / n,
+           c->debris.drawn / n, c->debris.culled / n,
+           c->sparks.drawn / n, c->sparks.culled / n);
+    if (capture) {
+        CaptureStats stats = capture_stats(capture);
+        printf("Capture: %d frames written, %d dropped, %d queued\n", stats.written, stats.dropped, stats.queued);
+    }
+    sound_system_report();
+    *report = (FrameReport){ .last_timestamp = timestamp };
+}
+
+// Runs one frame. The page calls it from requestAnimationFrame with the
+// callback's timestamp (template.html), the native loop with the frame start
+// from pacer_wait.
+// Nothing in here blocks, so the web build needs no ASYNCIFY. Returns 0 once
+// the game is over and no more frames should be scheduled.
+#ifdef __EMSCRIPTEN__
+EMSCRIPTEN_KEEPALIVE
+#endif
+int f22_step(double timestamp) {
+    GameContext* ctx = &g_ctx;
+    if (ctx->quit) return 0;
+
+    uint64_t start = SDL_GetPerformanceCounter();
+    main_loop(ctx);
+    double step_ms = (SDL_GetPerformanceCounter() - start) * 1000.0 / SDL_GetPerformanceFrequency();
+    frame_report_add(&ctx->report, timestamp, step_ms, &ctx->renderer.cull, ctx->renderer.capture);
+    return !ctx->quit;
+}
+
+#ifndef __EMSCRIPTEN__
+// Native command line:
+//   --vsync                 present on the vblank when the driver can
+//   --capture FILE          record every frame: Y4M if FILE ends in .y4m, raw
+//                           RGBA otherwise; "|command" pipes the frames
+//   --capture-format rgba|y4m
+//   --capture-budget MB     memory for frames waiting to be written
+typedef struct {
+    bool vsync;
+    const char* capture_path;
+    const char* capture_format;
+    long capture_budget_mb;
+} NativeOptions;
+
+// 1 .. CAPTURE_MAX_BUDGET_MB, or the default when the value is not a number
+static long parse_budget(const char* value) {
+    char* end;
+    long mb = strtol(value, &end, 10);
+    if (end == value || *end != '\0' || mb <= 0) {
+        printf("Invalid capture budget %s, using %d MB\n", value, CAPTURE_DEFAULT_BUDGET_MB);
+        return CAPTURE_DEFAULT_BUDGET_MB;
+    }
+    if (mb > CAPTURE_MAX_BUDGET_MB) {
+        printf("Capture budget %s MB capped at %d MB\n", value, CAPTURE_MAX_BUDGET_MB);
+        return CAPTURE_MAX_BUDGET_MB;
+    }
+    return mb;
+}
+
+static NativeOptions parse_options(int argc, char* argv[]) {
+    NativeOptions options = { .capture_budget_mb = CAPTURE_DEFAULT_BUDGET_MB };
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--vsync") == 0) {
+            options.vsync = true;
+            continue;
+        }
+        const char* value = i + 1 < argc ? argv[i + 1] : NULL;
+        if (!value) {
+            printf("Missing value for %s\n", argv[i]);
+            break;
         }
+        if (strcmp(argv[i], "--capture") == 0) options.capture_path = value;
+        else if (strcmp(argv[i], "--capture-format") == 0) options.capture_format = value;
+        else if (strcmp(argv[i], "--capture-budget") == 0) options.capture_budget_mb = parse_budget(value);
+        else printf("Unknown option %s\n", argv[i]);
+        i++;
+    }
+    return options;
+}
+
+static Capture* capture_from_options(SDL_Renderer* renderer, int fps, const NativeOptions* options) {
+    const char* path = options->capture_path;
+    if (!path) return NULL;
+
+    CaptureFormat format = CAPTURE_RGBA;
+    if (options->capture_format) {
+        if (strcmp(options->capture_format, "y4m") == 0) format = CAPTURE_Y4M;
+        else if (strcmp(options->capture_format, "rgba") != 0) printf("Unknown capture format %s, using rgba\n", options->capture_format);
+    } else {
+        size_t length = strlen(path);
+        if (length > 4 && strcmp(path + length - 4, ".y4m") == 0) format = CAPTURE_Y4M;
+    }
+
+    int width, height;
+    if (SDL_GetRendererOutputSize(renderer, &width, &height) != 0) {
+        printf("No renderer output size to capture: %s\n", SDL_GetError());
+        return NULL;
+    }
+    return capture_start(path, format, width, height, fps, (size_t)options->capture_budget_mb * 1024 * 1024);
+}
 
-        renderer_draw_frame(&ctx->renderer, &ctx->game_state, ctx->thrust_active);
-        ctx->accumulated_time -= FIXED_TIME_STEP;
+// Paces to the display's refresh rate if present waits for the vblank,
+// otherwise to target_fps, and gives dynamic resolution the same frame
+// budget; returns the rate used
+static double pacer_setup(GameContext* ctx, bool vsync_requested) {
+    SDL_RendererInfo info;
+    SDL_GetRendererInfo(ctx->renderer.renderer, &info);
+    bool vsync = (info.flags & SDL_RENDERER_PRESENTVSYNC) != 0;
+
+    double fps = ctx->target_fps;
+    SDL_DisplayMode mode;
+    if (vsync && SDL_GetCurrentDisplayMode(SDL_GetWindowDisplayIndex(ctx->renderer.window), &mode) == 0 &&
+        mode.refresh_rate > 0) {
+        fps = mode.refresh_rate;
+    }
+    if (vsync_requested && !vsync) {
+        printf("Vsync not available, pacing to %.0f fps\n", fps);
     }
+    pacer_init(&ctx->pacer, fps, vsync);
+    dynres_set_refresh(&ctx->renderer.dynres, 1000.0 / fps, ctx->pacer.vsync);
+    return fps;
 }
+#endif
 
-int main() {
-    srand(time(NULL));  // seed random for track selection
+int main(int argc, char* argv[]) {
+    uint64_t launch_time = SDL_GetPerformanceCounter();
+    uint64_t seed = (uint64_t)time(NULL);  // every subsystem derives its own stream from this
     #ifdef __EMSCRIPTEN__
     setvbuf(stdout, NULL, _IOLBF, 0);
+    (void)argc;
+    (void)argv;
+    #else
+    NativeOptions options = parse_options(argc, argv);
+    if (options.vsync) SDL_SetHint(SDL_HINT_RENDER_VSYNC, "1");
     #endif
 
     if (SDL_Init(SDL_INIT_VIDEO | SDL_INIT_AUDIO) < 0) {
@@ -121,56 +304,80 @@ int main() {
         return 1;
     }
 
+    // Sound loading reads from the pack, so open it before the game state
+    #ifdef __EMSCRIPTEN__
+    pack_open("/assets.pak");
+    #else
+    char* base_path = SDL_GetBasePath();
+    char pack_path[1024];
+    snprintf(pack_path, sizeof(pack_path), "%sassets.pak", base_path ? base_path : "");
+    SDL_free(base_path);
+    pack_open(pack_path);
+    #endif
+
+    // Sound effects are only queued here; decoding starts with loader_start
+    Loader* loader = loader_create();
+
     // Initialize context with new timing variables
-    GameContext ctx = {
+    GameContext* ctx = &g_ctx;
+    *ctx = (GameContext){
         .quit = false,
         .thrust_active = false,
-        .game_state = game_state_init(),
-        .last_frame_time = SDL_GetTicks(),  // Initialize timing
-        .delta_time = 0.0f,
-        .accumulated_time = 0.0f,
-        .target_fps = 60.0f,  // Set target frame rate
-        .frame_time = 1000.0f / 60.0f  // Calculate ms per frame (33.33ms for 30fps)
+        .loader = loader,
+        .launch_time = launch_time,
+        .target_fps = 60.0f  // Set target frame rate
     };
+    ctx->game_state = game_state_init(seed, loader);
+
+    loader_start(ctx->loader);
 
-    if (renderer_init(&ctx.renderer) < 0) {
+    ctx->jobs = jobs_create(-1);
+    ctx->game_state.jobs = ctx->jobs;
+
+    if (renderer_init(&ctx->renderer, ctx->jobs, seed) < 0) {
         SDL_Log("Renderer init failed: %s", SDL_GetError());
+        loader_destroy(ctx->loader);
         SDL_Quit();
         return 1;
     }
 
     SDL_Rect viewport;
-    SDL_RenderGetViewport(ctx.renderer.renderer, &viewport);
+    SDL_RenderGetViewport(ctx->renderer.renderer, &viewport);
     printf("Viewport size: x=%d, y=%d, w=%d, h=%d\n",
            viewport.x, viewport.y, viewport.w, viewport.h);
 
     // Force the viewport size
-    SDL_RenderSetLogicalSize(ctx.renderer.renderer, WINDOW_WIDTH, WINDOW_HEIGHT);
+    SDL_RenderSetLogicalSize(ctx->renderer.renderer, WINDOW_WIDTH, WINDOW_HEIGHT);
 
-    #ifdef EMSCRIPTEN
-        // Set up frame-capped main loop for web
-        // The '0' parameter lets Emscripten handle timing
-        // The '1' means to simulate infinite loop
-        emscripten_set_main_loop_arg(main_loop, &ctx, 0, 1);
+    #ifndef __EMSCRIPTEN__
+    double fps = pacer_setup(ctx, options.vsync);
+    ctx->renderer.capture = capture_from_options(ctx->renderer.renderer, (int)lround(fps), &options);
+    #endif
+
+    ctx->sim = sim_create(&ctx->game_state);
+    ctx->sim_threaded = sim_start(ctx->sim);
+
+    #ifdef __EMSCRIPTEN__
+    // The page starts calling f22_step once main returns. The runtime stays
+    // alive (no EXIT_RUNTIME), so the web build never tears anything down.
+    return 0;
     #else
-    // Native build - manual frame timing
-    while (!ctx.quit) {
-        uint32_t current_time = SDL_GetTicks();
-        uint32_t delta = current_time - ctx.last_frame_time;
-        
-        // Only update if enough time has passed
-        if (delta >= ctx.frame_time) {
-            ctx.delta_time = delta / 1000.0f;  // Convert to seconds
-            main_loop(&ctx);
-            ctx.last_frame_time = current_time;
-        } else {
-            // Sleep to avoid maxing CPU
-            SDL_Delay(1);
-        }
+    // Native build - the pacer waits for each frame (src/pacer.h)
+    while (!ctx->quit) {
+        f22_step(pacer_wait(&ctx->pacer));
+        if (ctx->pacer.frames >= FRAME_REPORT_FRAMES) pacer_report(&ctx->pacer);
     }
-    #endif
 
-    renderer_cleanup(&ctx.renderer);
+    loader_destroy(ctx->loader);
+    sim_destroy(ctx->sim);
+    // Music and the cached effects read from the pack (and the PCM cache's
+    // mappings), so the mixer has to stop before pack_close
+    sound_system_cleanup(&ctx->game_state.sound_system);
+    capture_stop(ctx->renderer.capture);
+    renderer_cleanup(&ctx->renderer);
+    jobs_destroy(ctx->jobs);
+    pack_close();
     SDL_Quit();
     return 0;
+    #endif
 }
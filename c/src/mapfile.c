@@ -0,0 +1,80 @@
+#include "mapfile.h"
+#include <SDL.h>
+#include <string.h>
+
+#ifdef __EMSCRIPTEN__
+#elif defined(_WIN32)
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+bool mapfile_open(MappedFile* file, const char* path, bool copy_on_write) {
+    memset(file, 0, sizeof(*file));
+
+    #ifdef __EMSCRIPTEN__
+    (void)copy_on_write;
+    size_t size = 0;
+    void* data = SDL_LoadFile(path, &size);
+    if (!data) return false;
+    file->data = data;
+    file->size = size;
+    return true;
+    #elif defined(_WIN32)
+    HANDLE handle = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL,
+                                OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (handle == INVALID_HANDLE_VALUE) return false;
+    LARGE_INTEGER size;
+    GetFileSizeEx(handle, &size);
+    HANDLE mapping = CreateFileMappingA(handle, NULL,
+                                        copy_on_write ? PAGE_WRITECOPY : PAGE_READONLY,
+                                        0, 0, NULL);
+    if (!mapping) {
+        CloseHandle(handle);
+        return false;
+    }
+    void* view = MapViewOfFile(mapping, copy_on_write ? FILE_MAP_COPY : FILE_MAP_READ, 0, 0, 0);
+    if (!view) {
+        CloseHandle(mapping);
+        CloseHandle(handle);
+        return false;
+    }
+    file->data = view;
+    file->size = (size_t)size.QuadPart;
+    file->file = handle;
+    file->mapping = mapping;
+    return true;
+    #else
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return false;
+    struct stat st;
+    if (fstat(fd, &st) < 0 || st.st_size <= 0) {
+        close(fd);
+        return false;
+    }
+    int protection = copy_on_write ? PROT_READ | PROT_WRITE : PROT_READ;
+    void* base = mmap(NULL, (size_t)st.st_size, protection, MAP_PRIVATE, fd, 0);
+    close(fd);  // the mapping keeps the file alive
+    if (base == MAP_FAILED) return false;
+    file->data = base;
+    file->size = (size_t)st.st_size;
+    return true;
+    #endif
+}
+
+void mapfile_close(MappedFile* file) {
+    if (!file->data) return;
+    #ifdef __EMSCRIPTEN__
+    SDL_free(file->data);
+    #elif defined(_WIN32)
+    UnmapViewOfFile(file->data);
+    CloseHandle(file->mapping);
+    CloseHandle(file->file);
+    #else
+    munmap(file->data, file->size);
+    #endif
+    memset(file, 0, sizeof(*file));
+}
@@ -0,0 +1,22 @@
+#ifndef MAPFILE_H
+#define MAPFILE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// A whole file mapped into memory: mmap natively, MapViewOfFile on Windows.
+// MEMFS has no real mmap, so the web build reads the file into the heap.
+typedef struct {
+    uint8_t* data;
+    size_t size;
+    void* file;      // Windows handles
+    void* mapping;
+} MappedFile;
+
+// copy_on_write maps private writable pages, for buffers handed to APIs that
+// take non-const pointers; otherwise the pages are read-only
+bool mapfile_open(MappedFile* file, const char* path, bool copy_on_write);
+void mapfile_close(MappedFile* file);
+
+#endif // MAPFILE_H
@@ -0,0 +1,67 @@
+#include "pacer.h"
+#include <math.h>
+#include <stdio.h>
+
+void pacer_init(FramePacer* pacer, double fps, bool vsync) {
+    *pacer = (FramePacer){ .frequency = SDL_GetPerformanceFrequency(), .vsync = vsync };
+    pacer->period = (uint64_t)llround(pacer->frequency / fps);
+}
+
+static double pacer_ms(const FramePacer* pacer, int64_t ticks) {
+    return ticks * 1000.0 / pacer->frequency;
+}
+
+static void pacer_record(FramePacer* pacer, uint64_t now) {
+    if (pacer->last == 0) return;
+    double jitter = fabs(pacer_ms(pacer, (int64_t)(now - pacer->last)) - pacer_ms(pacer, (int64_t)pacer->period));
+    int bin = (int)(jitter / PACER_BIN_MS);
+    if (bin > PACER_BINS - 1) bin = PACER_BINS - 1;
+    pacer->histogram[bin]++;
+    pacer->frames++;
+    pacer->jitter_total_ms += jitter;
+    if (jitter > pacer->jitter_max_ms) pacer->jitter_max_ms = jitter;
+}
+
+double pacer_wait(FramePacer* pacer) {
+    uint64_t now = SDL_GetPerformanceCounter();
+    if (!pacer->vsync && pacer->next != 0) {
+        // Coarse sleep first; SDL_Delay(0) just yields when under 2 ms remain
+        double remaining = pacer_ms(pacer, (int64_t)(pacer->next - now));
+        while (remaining > PACER_SPIN_MS) {
+            SDL_Delay((uint32_t)(remaining - PACER_SPIN_MS));
+            now = SDL_GetPerformanceCounter();
+            remaining = pacer_ms(pacer, (int64_t)(pacer->next - now));
+        }
+        while ((int64_t)(pacer->next - now) > 0) {
+            now = SDL_GetPerformanceCounter();
+        }
+    }
+
+    if (pacer->next == 0 || (int64_t)(now - pacer->next) > (int64_t)pacer->period) {
+        pacer->next = now + pacer->period;
+    } else {
+        pacer->next += pacer->period;
+    }
+    pacer_record(pacer, now);
+    pacer->last = now;
+    return pacer_ms(pacer, (int64_t)now);
+}
+
+void pacer_report(FramePacer* pacer) {
+    if (pacer->frames == 0) return;
+    printf("Frame jitter vs %.2f ms%s: avg %.3f ms, max %.3f ms\n ",
+           pacer_ms(pacer, (int64_t)pacer->period), pacer->vsync ? " (vsync)" : "",
+           pacer->jitter_total_ms / pacer->frames, pacer->jitter_max_ms);
+    for (int i = 0; i < PACER_BINS; i++) {
+        if (pacer->histogram[i] == 0) continue;
+        if (i == PACER_BINS - 1) printf(" >=%.2f:%d", i * PACER_BIN_MS, pacer->histogram[i]);
+        else printf(" <%.2f:%d", (i + 1) * PACER_BIN_MS, pacer->histogram[i]);
+    }
+    printf("\n");
+
+    for (int i = 0; i < PACER_BINS; i++) {
+        pacer->histogram[i] = 0;
+    }
+    pacer->frames = 0;
+    pacer->jitter_total_ms = pacer->jitter_max_ms = 0.0;
+}
@@ -0,0 +1,42 @@
+#ifndef PACER_H
+#define PACER_H
+
+#include <SDL.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#define PACER_SPIN_MS 1.0        // busy-wait this close to the deadline
+#define PACER_BIN_MS 0.25        // jitter histogram resolution
+#define PACER_BINS 16            // the last bin also holds everything later
+
+// Native frame pacing on the performance counter. pacer_wait sleeps with
+// SDL_Delay while more than PACER_SPIN_MS remains, since a sleep can
+// overshoot by about a millisecond, and spins for the rest. Deadlines
+// advance by a whole period from the previous one, so one late frame does
+// not shift every later frame. If the loop falls more than a frame behind,
+// the schedule restarts from now instead of catching up in a burst.
+//
+// With vsync, SDL_RenderPresent already blocks until the vblank, so the
+// pacer does not wait at all and only measures against the display's
+// refresh period.
+typedef struct {
+    uint64_t frequency;
+    uint64_t period;             // counter ticks per frame
+    uint64_t next;               // when the next frame is due, 0 before the first
+    uint64_t last;               // start of the previous frame
+    bool vsync;
+    int histogram[PACER_BINS];   // |interval - period|, one bin per PACER_BIN_MS
+    int frames;
+    double jitter_total_ms;
+    double jitter_max_ms;
+} FramePacer;
+
+void pacer_init(FramePacer* pacer, double fps, bool vsync);
+
+// Returns once the next frame is due, with its start time in ms
+double pacer_wait(FramePacer* pacer);
+
+// Prints the jitter histogram since the last report and clears it
+void pacer_report(FramePacer* pacer);
+
+#endif // PACER_H
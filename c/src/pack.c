@@ -0,0 +1,220 @@
+#include "pack.h"
+#include "mapfile.h"
+#include <stdio.h>
+#include <string.h>
+
+#ifdef __EMSCRIPTEN__
+#include <emscripten.h>
+#endif
+#ifdef __EMSCRIPTEN_PTHREADS__
+#include <emscripten/proxying.h>
+#include <emscripten/threading.h>
+#endif
+
+#define PACK_VERSION 1
+#define PACK_EXTERNAL 1  // indexed only; the data lives next to the page
+
+// Download state of an external entry
+enum {
+    FETCH_IDLE,
+    FETCH_PENDING,
+    FETCH_FAILED
+};
+
+// On-disk layout, see tools/pack_assets.py
+typedef struct {
+    char magic[4];
+    uint32_t version;
+    uint32_t count;
+    uint32_t reserved;
+} PackHeader;
+
+typedef struct {
+    char name[PACK_NAME_SIZE];
+    uint32_t offset;
+    uint32_t size;
+    uint32_t flags;
+    uint32_t reserved;
+} PackEntry;
+
+typedef struct {
+    MappedFile file;
+    const PackEntry* entries;
+    uint32_t count;
+
+    // External entries that have been downloaded (web only)
+    void** fetched;          // data pointers, published atomically
+    uint32_t* fetched_size;
+    SDL_atomic_t* fetch_state;
+} Pack;
+
+static Pack g_pack;
+
+static bool pack_validate(void) {
+    const uint8_t* base = g_pack.file.data;
+    size_t size = g_pack.file.size;
+    if (size < sizeof(PackHeader)) return false;
+    const PackHeader* header = (const PackHeader*)base;
+    if (memcmp(header->magic, "F22P", 4) != 0 || header->version != PACK_VERSION) return false;
+    if (header->count > (size - sizeof(PackHeader)) / sizeof(PackEntry)) return false;
+
+    const PackEntry* entries = (const PackEntry*)(base + sizeof(PackHeader));
+    for (uint32_t i = 0; i < header->count; i++) {
+        if (entries[i].name[PACK_NAME_SIZE - 1] != '\0') return false;
+        if (entries[i].flags & PACK_EXTERNAL) continue;
+        if ((size_t)entries[i].offset + entries[i].size > size) return false;
+    }
+    g_pack.entries = entries;
+    g_pack.count = header->count;
+    return true;
+}
+
+bool pack_open(const char* path) {
+    if (!mapfile_open(&g_pack.file, path, false)) {
+        printf("No asset pack at %s, using loose files\n", path);
+        return false;
+    }
+    if (!pack_validate()) {
+        printf("Asset pack %s is corrupt or from another version\n", path);
+        mapfile_close(&g_pack.file);
+        return false;
+    }
+
+    g_pack.fetched = SDL_calloc(g_pack.count, sizeof(void*));
+    g_pack.fetched_size = SDL_calloc(g_pack.count, sizeof(uint32_t));
+    g_pack.fetch_state = SDL_calloc(g_pack.count, sizeof(SDL_atomic_t));
+    return true;
+}
+
+void pack_close(void) {
+    for (uint32_t i = 0; i < g_pack.count; i++) {
+        SDL_free(g_pack.fetched[i]);
+    }
+    SDL_free(g_pack.fetched);
+    SDL_free(g_pack.fetched_size);
+    SDL_free(g_pack.fetch_state);
+    mapfile_close(&g_pack.file);
+    memset(&g_pack, 0, sizeof(g_pack));
+}
+
+static int pack_find(const char* name) {
+    // A handful of entries, looked up a few times per track change
+    for (uint32_t i = 0; i < g_pack.count; i++) {
+        if (strcmp(g_pack.entries[i].name, name) == 0) return (int)i;
+    }
+    return -1;
+}
+
+SDL_RWops* pack_open_rw(const char* name) {
+    if (!g_pack.file.data) {
+        char path[PACK_NAME_SIZE + 16];
+        #ifdef __EMSCRIPTEN__
+        snprintf(path, sizeof(path), "/assets/%s", name);
+        #else
+        snprintf(path, sizeof(path), "assets/%s", name);
+        #endif
+        return SDL_RWFromFile(path, "rb");
+    }
+
+    int index = pack_find(name);
+    if (index < 0) {
+        SDL_SetError("%s is not in the asset pack", name);
+        return NULL;
+    }
+
+    const PackEntry* entry = &g_pack.entries[index];
+    if (entry->flags & PACK_EXTERNAL) {
+        void* data = SDL_AtomicGetPtr(&g_pack.fetched[index]);
+        if (!data) {
+            SDL_SetError("%s has not been downloaded yet", name);
+            return NULL;
+        }
+        return SDL_RWFromConstMem(data, (int)g_pack.fetched_size[index]);
+    }
+    return SDL_RWFromConstMem(g_pack.file.data + entry->offset, (int)entry->size);
+}
+
+const void* pack_data(const char* name, size_t* size) {
+    if (!g_pack.file.data) return NULL;
+    int index = pack_find(name);
+    if (index < 0) return NULL;
+
+    const PackEntry* entry = &g_pack.entries[index];
+    if (entry->flags & PACK_EXTERNAL) {
+        void* data = SDL_AtomicGetPtr(&g_pack.fetched[index]);
+        if (data) *size = g_pack.fetched_size[index];
+        return data;
+    }
+    *size = entry->size;
+    return g_pack.file.data + entry->offset;
+}
+
+PackStatus pack_status(const char* name) {
+    if (!g_pack.file.data) return PACK_RESIDENT;  // loose files; opening will tell
+    int index = pack_find(name);
+    if (index < 0) return PACK_MISSING;
+    if (!(g_pack.entries[index].flags & PACK_EXTERNAL)) return PACK_RESIDENT;
+    if (SDL_AtomicGetPtr(&g_pack.fetched[index])) return PACK_RESIDENT;
+
+    switch (SDL_AtomicGet(&g_pack.fetch_state[index])) {
+        case FETCH_PENDING: return PACK_FETCHING;
+        case FETCH_FAILED: return PACK_FETCH_FAILED;
+        default: return PACK_REMOTE;
+    }
+}
+
+bool pack_is_resident(const char* name) {
+    return pack_status(name) == PACK_RESIDENT;
+}
+
+#ifdef __EMSCRIPTEN__
+static void pack_fetch_loaded(void* arg, void* data, int size) {
+    int index = (int)(intptr_t)arg;
+
+    // The wget buffer is freed when this returns
+    void* copy = SDL_malloc((size_t)size);
+    if (!copy) {
+        SDL_AtomicSet(&g_pack.fetch_state[index], FETCH_FAILED);
+        return;
+    }
+    memcpy(copy, data, (size_t)size);
+    g_pack.fetched_size[index] = (uint32_t)size;
+    SDL_AtomicSetPtr(&g_pack.fetched[index], copy);
+    SDL_AtomicSet(&g_pack.fetch_state[index], FETCH_IDLE);
+}
+
+static void pack_fetch_failed(void* arg) {
+    int index = (int)(intptr_t)arg;
+    printf("Failed to download %s\n", g_pack.entries[index].name);
+    SDL_AtomicSet(&g_pack.fetch_state[index], FETCH_FAILED);
+}
+
+static void pack_fetch_start(void* arg) {
+    int index = (int)(intptr_t)arg;
+    char url[PACK_NAME_SIZE + 16];
+    snprintf(url, sizeof(url), "assets/%s", g_pack.entries[index].name);
+    emscripten_async_wget_data(url, arg, pack_fetch_loaded, pack_fetch_failed);
+}
+#endif
+
+void pack_fetch(const char* name) {
+    #ifdef __EMSCRIPTEN__
+    if (!g_pack.file.data) return;
+    if (pack_status(name) != PACK_REMOTE) return;
+    int index = pack_find(name);
+    if (!SDL_AtomicCAS(&g_pack.fetch_state[index], FETCH_IDLE, FETCH_PENDING)) return;
+
+    // The music thread asks for tracks too, but wget callbacks only arrive on
+    // a thread that returns to the browser's event loop
+    #ifdef __EMSCRIPTEN_PTHREADS__
+    if (!emscripten_is_main_runtime_thread()) {
+        emscripten_proxy_async(emscripten_proxy_get_system_queue(), emscripten_main_runtime_thread_id(),
+                               pack_fetch_start, (void*)(intptr_t)index);
+        return;
+    }
+    #endif
+    pack_fetch_start((void*)(intptr_t)index);
+    #else
+    (void)name;
+    #endif
+}
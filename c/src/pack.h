@@ -0,0 +1,43 @@
+#ifndef PACK_H
+#define PACK_H
+
+#include <SDL.h>
+#include <stdbool.h>
+
+// Read-only asset archive written by tools/pack_assets.py. Natively the whole
+// file is memory-mapped and entries are served straight out of the mapping.
+// The web build preloads only the index and the sound effects; entries marked
+// external are downloaded on request with pack_fetch.
+//
+// Names are relative to the assets directory, e.g. "sounds/engine.mp3".
+
+#define PACK_NAME_SIZE 48
+
+typedef enum {
+    PACK_MISSING,       // not in the index
+    PACK_RESIDENT,      // pack_open_rw will succeed
+    PACK_REMOTE,        // external, not requested yet
+    PACK_FETCHING,
+    PACK_FETCH_FAILED   // gave up; pack_fetch will not retry
+} PackStatus;
+
+bool pack_open(const char* path);
+void pack_close(void);
+
+// Zero-copy reader over an entry (pass freesrc=1 to the Mix_Load*_RW call).
+// Returns NULL if the entry is unknown or not downloaded yet. Without a pack
+// it falls back to the loose file under assets/.
+SDL_RWops* pack_open_rw(const char* name);
+
+// Direct pointer to an entry's bytes (NULL under the same conditions as
+// pack_open_rw, and always NULL without a pack). Valid until pack_close.
+const void* pack_data(const char* name, size_t* size);
+
+// True when pack_open_rw can serve the entry right now
+bool pack_is_resident(const char* name);
+PackStatus pack_status(const char* name);
+
+// Starts downloading an external entry; no-op unless its status is PACK_REMOTE
+void pack_fetch(const char* name);
+
+#endif // PACK_H
@@ -0,0 +1,154 @@
+#include "pcm_cache.h"
+#include <stdio.h>
+#include <string.h>
+#include "mapfile.h"
+#include "pack.h"
+
+#define PCM_CACHE_MAX 8   // mapped chunks alive at once
+
+typedef struct {
+    Mix_Chunk* chunk;
+    MappedFile file;
+} PcmMapping;
+
+static PcmMapping g_mappings[PCM_CACHE_MAX];
+static SDL_SpinLock g_mappings_lock;
+
+// Mixer output format as it appears in cache names, e.g. "44100-8010-2"
+static bool pcm_format_key(char* key, size_t size, int* frame_bytes) {
+    int frequency, channels;
+    Uint16 format;
+    if (!Mix_QuerySpec(&frequency, &format, &channels)) return false;
+    snprintf(key, size, "%d-%04x-%d", frequency, format, channels);
+    *frame_bytes = (SDL_AUDIO_BITSIZE(format) / 8) * channels;
+    return true;
+}
+
+static Mix_Chunk* pcm_quick_load(uint8_t* data, size_t size, int frame_bytes) {
+    // Whole frames only; anything else is a truncated or foreign file
+    if (size == 0 || size % (size_t)frame_bytes != 0 || size > UINT32_MAX) return NULL;
+    return Mix_QuickLoad_RAW(data, (Uint32)size);
+}
+
+#ifdef __EMSCRIPTEN__
+static Mix_Chunk* pcm_cache_find(const char* name, const char* key, int frame_bytes) {
+    char entry[PACK_NAME_SIZE];
+    snprintf(entry, sizeof(entry), "pcm/%s.%s.raw", name, key);
+
+    // The web pack lives on the heap, so the mixer may have the pointer
+    size_t size = 0;
+    uint8_t* data = (uint8_t*)pack_data(entry, &size);
+    return data ? pcm_quick_load(data, size, frame_bytes) : NULL;
+}
+#else
+// FNV-1a, plenty to tell asset revisions apart
+static uint64_t pcm_hash(const uint8_t* data, size_t size) {
+    uint64_t hash = 14695981039346656037ull;
+    for (size_t i = 0; i < size; i++) {
+        hash ^= data[i];
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+static bool pcm_cache_path(char* path, size_t size, const char* name, uint64_t hash, const char* key) {
+    char* dir = SDL_GetPrefPath("f22", "raptor");
+    if (!dir) return false;
+    const char* base = strrchr(name, '/');
+    snprintf(path, size, "%s%s-%016llx-%s.pcm", dir, base ? base + 1 : name,
+             (unsigned long long)hash, key);
+    SDL_free(dir);
+    return true;
+}
+
+static Mix_Chunk* pcm_cache_map(const char* path, int frame_bytes) {
+    MappedFile file;
+    if (!mapfile_open(&file, path, true)) return NULL;  // the mixer takes non-const buffers
+    Mix_Chunk* chunk = pcm_quick_load(file.data, file.size, frame_bytes);
+
+    SDL_AtomicLock(&g_mappings_lock);
+    int slot = -1;
+    for (int i = 0; i < PCM_CACHE_MAX && chunk; i++) {
+        if (!g_mappings[i].chunk) {
+            g_mappings[i] = (PcmMapping){ chunk, file };
+            slot = i;
+            break;
+        }
+    }
+    SDL_AtomicUnlock(&g_mappings_lock);
+
+    if (slot < 0) {
+        if (chunk) Mix_FreeChunk(chunk);
+        mapfile_close(&file);
+        return NULL;
+    }
+    return chunk;
+}
+
+static void pcm_cache_store(const char* path, const Mix_Chunk* chunk) {
+    // Write aside and rename, so a crash never leaves a short entry behind
+    char tmp[1024 + 8];
+    snprintf(tmp, sizeof(tmp), "%s.tmp", path);
+    SDL_RWops* rw = SDL_RWFromFile(tmp, "wb");
+    if (!rw) return;
+    bool ok = SDL_RWwrite(rw, chunk->abuf, 1, chunk->alen) == chunk->alen;
+    ok = SDL_RWclose(rw) == 0 && ok;
+
+    #ifdef _WIN32
+    remove(path);  // rename does not replace there
+    #endif
+    if (!ok || rename(tmp, path) != 0) {
+        printf("Failed to write PCM cache %s\n", path);
+        remove(tmp);
+    }
+}
+#endif
+
+Mix_Chunk* pcm_cache_load(const char* name) {
+    char key[32];
+    int frame_bytes;
+    if (!pcm_format_key(key, sizeof(key), &frame_bytes)) return NULL;
+
+    #ifdef __EMSCRIPTEN__
+    Mix_Chunk* cached = pcm_cache_find(name, key, frame_bytes);
+    if (cached) return cached;
+    return Mix_LoadWAV_RW(pack_open_rw(name), 1);
+    #else
+    // Hash the compressed source straight out of the pack when there is one
+    size_t size = 0;
+    void* loaded = NULL;
+    const void* source = pack_data(name, &size);
+    if (!source) {
+        SDL_RWops* rw = pack_open_rw(name);
+        source = loaded = rw ? SDL_LoadFile_RW(rw, &size, 1) : NULL;
+        if (!source) return NULL;
+    }
+
+    char path[1024];
+    bool cacheable = pcm_cache_path(path, sizeof(path), name, pcm_hash(source, size), key);
+    Mix_Chunk* chunk = cacheable ? pcm_cache_map(path, frame_bytes) : NULL;
+    if (!chunk) {
+        chunk = Mix_LoadWAV_RW(SDL_RWFromConstMem(source, (int)size), 1);
+        if (chunk && cacheable) pcm_cache_store(path, chunk);
+    }
+    SDL_free(loaded);
+    return chunk;
+    #endif
+}
+
+void pcm_cache_free(Mix_Chunk* chunk) {
+    if (!chunk) return;
+    Mix_FreeChunk(chunk);  // leaves Mix_QuickLoad_RAW buffers alone
+
+    #ifndef __EMSCRIPTEN__
+    SDL_AtomicLock(&g_mappings_lock);
+    for (int i = 0; i < PCM_CACHE_MAX; i++) {
+        if (g_mappings[i].chunk == chunk) {
+            mapfile_close(&g_mappings[i].file);
+            g_mappings[i].chunk = NULL;
+            break;
+        }
+    }
+    SDL_AtomicUnlock(&g_mappings_lock);
+    #endif
+}
@@ -0,0 +1,23 @@
+#ifndef PCM_CACHE_H
+#define PCM_CACHE_H
+
+#include <SDL_mixer.h>
+
+// Sound effects decoded once into the mixer's output format and reused, so
+// later launches skip the MP3 decode and create chunks with Mix_QuickLoad_RAW.
+//
+// Native: <pref path>/<file>-<source hash>-<rate>-<format>-<channels>.pcm,
+// written after the first decode and memory-mapped on later runs. A changed
+// source file or mixer format simply misses and writes a new entry.
+//
+// Web: the pack carries blobs decoded at build time (see CMakeLists.txt) as
+// pcm/<name>.<rate>-<format>-<channels>.raw. They are used when the
+// AudioContext runs at that rate; otherwise the MP3 is decoded as before.
+
+// Call with the device open; returns NULL with the mixer error set on failure
+Mix_Chunk* pcm_cache_load(const char* name);
+
+// Frees a chunk from pcm_cache_load along with any mapping behind it
+void pcm_cache_free(Mix_Chunk* chunk);
+
+#endif // PCM_CACHE_H
@@ -3,6 +3,7 @@
 #define PLAYER_H
 
 #include "f22.h"
+#include "canvas.h"
 #include <SDL.h>
 #include <math.h>
 
@@ -44,7 +45,12 @@ typedef struct {
 } EdgePoint;
 
 // Helper function to fill a polygon
-static void fill_polygon(SDL_Renderer* renderer, SDL_Point* points, int num_points) {
+static void fill_polygon(const Canvas* canvas, SDL_Point* points, int num_points) {
+    if (canvas->raster) {
+        raster_fill_polygon(canvas->raster, points, num_points);
+        return;
+    }
+
     // Find min and max y coordinates to know where to scan
     int min_y = points[0].y;
     int max_y = points[0].y;
@@ -90,7 +96,7 @@ static void fill_polygon(SDL_Renderer* renderer, SDL_Point* points, int num_poin
 
         // Draw horizontal lines between pairs of intersections
         for (int i = 0; i < num_intersections - 1; i += 2) {
-            SDL_RenderDrawLine(renderer, 
+            SDL_RenderDrawLine(canvas->sdl, 
                 intersections[i].x, y,
                 intersections[i + 1].x, y);
         }
@@ -0,0 +1,61 @@
+#include "quality.h"
+#include <stdio.h>
+
+// One row per level; each changes a single knob from the row above
+static const QualitySettings QUALITY_LEVELS[] = {
+    { .trail_step = 1, .spark_limit = 64, .star_count = 50, .barrier_points = 200, .wave_step = 1 },
+    { .trail_step = 2, .spark_limit = 64, .star_count = 50, .barrier_points = 200, .wave_step = 1 },
+    { .trail_step = 4, .spark_limit = 64, .star_count = 50, .barrier_points = 200, .wave_step = 1 },
+    { .trail_step = 4, .spark_limit = 32, .star_count = 50, .barrier_points = 200, .wave_step = 1 },
+    { .trail_step = 4, .spark_limit = 16, .star_count = 50, .barrier_points = 200, .wave_step = 1 },
+    { .trail_step = 4, .spark_limit = 16, .star_count = 25, .barrier_points = 200, .wave_step = 1 },
+    { .trail_step = 4, .spark_limit = 16, .star_count = 25, .barrier_points = 100, .wave_step = 1 },
+    { .trail_step = 4, .spark_limit = 16, .star_count = 25, .barrier_points = 100, .wave_step = 2 },
+};
+#define QUALITY_LEVEL_COUNT (int)(sizeof(QUALITY_LEVELS) / sizeof(QUALITY_LEVELS[0]))
+
+void quality_init(QualityGovernor* governor) {
+    *governor = (QualityGovernor){ .settings = QUALITY_LEVELS[0] };
+}
+
+void quality_begin(QualityGovernor* governor) {
+    governor->frame_start = SDL_GetPerformanceCounter();
+}
+
+void quality_end(QualityGovernor* governor) {
+    double frame_ms = (SDL_GetPerformanceCounter() - governor->frame_start) * 1000.0 /
+                      SDL_GetPerformanceFrequency();
+    if (governor->average_ms == 0.0f) {
+        governor->average_ms = (float)frame_ms;
+    } else {
+        governor->average_ms += ((float)frame_ms - governor->average_ms) * QUALITY_SMOOTHING;
+    }
+
+    if (governor->pinned) return;
+    if (governor->cooldown > 0) {
+        governor->cooldown--;
+        return;
+    }
+
+    int level = governor->level;
+    if (governor->average_ms > QUALITY_HIGH_MS && level < QUALITY_LEVEL_COUNT - 1) {
+        level++;
+    } else if (governor->average_ms < QUALITY_LOW_MS && level > 0) {
+        level--;
+    }
+    if (level == governor->level) return;
+
+    governor->level = level;
+    governor->settings = QUALITY_LEVELS[level];
+    governor->cooldown = QUALITY_COOLDOWN;
+    printf("Quality level %d of %d (draw %.2f ms avg)\n", level, QUALITY_LEVEL_COUNT - 1, governor->average_ms);
+}
+
+int quality_set_level(QualityGovernor* governor, int level) {
+    if (level < 0) level = 0;
+    if (level > QUALITY_LEVEL_COUNT - 1) level = QUALITY_LEVEL_COUNT - 1;
+    governor->level = level;
+    governor->settings = QUALITY_LEVELS[level];
+    governor->pinned = true;
+    return level;
+}
@@ -0,0 +1,47 @@
+#ifndef QUALITY_H
+#define QUALITY_H
+
+#include <SDL.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#define QUALITY_HIGH_MS 8.0f      // average draw time that lowers the detail
+#define QUALITY_LOW_MS 5.0f       // and the one that raises it again
+#define QUALITY_SMOOTHING 0.1f    // weight of the newest frame in the average
+#define QUALITY_COOLDOWN 30       // frames after a change before the next one
+
+// Effect detail the renderer reads every frame. Full detail is the
+// original fixed constants.
+typedef struct {
+    int trail_step;        // every nth asteroid trail point (1 = all 100)
+    int spark_limit;       // explosion sparks drawn, of MAX_SPARKS
+    int star_count;        // background stars, of 50
+    int barrier_points;    // points per barrier line, of 200
+    int wave_step;         // wave drawn through every nth column
+} QualitySettings;
+
+// Steps the detail one level at a time in a fixed priority order: asteroid
+// trails first, then sparks, stars, the barrier and, last, the wave the
+// player flies along. Only the CPU side of drawing is measured (up to
+// SDL_RenderPresent); dynamic resolution (src/dynres.h) also times present,
+// where a GPU that falls behind stalls, and trades pixels instead of detail.
+typedef struct {
+    QualitySettings settings;
+    int level;             // 0 = full detail
+    bool pinned;           // set by quality_set_level; no adapting
+    float average_ms;
+    int cooldown;
+    uint64_t frame_start;
+} QualityGovernor;
+
+void quality_init(QualityGovernor* governor);
+void quality_begin(QualityGovernor* governor);
+
+// Call before SDL_RenderPresent; picks the settings for the next frame
+void quality_end(QualityGovernor* governor);
+
+// Fixes the level (clamped to the available ones) and stops adapting;
+// returns the level used
+int quality_set_level(QualityGovernor* governor, int level);
+
+#endif // QUALITY_H
@@ -0,0 +1,383 @@
+#include "raster.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#ifdef __wasm_simd128__
+#include <wasm_simd128.h>
+#endif
+
+#define RASTER_INITIAL_COMMANDS 4096
+#define RASTER_INITIAL_POINTS 1024
+
+// One band of rows of the locked region
+typedef struct {
+    uint32_t* pixels;
+    int pitch;
+    int width;
+    int top, bottom;       // rows [top, bottom)
+} RasterBand;
+
+bool raster_init(Raster* raster, SDL_Renderer* renderer, JobSystem* jobs, int width, int height) {
+    *raster = (Raster){ .width = width, .height = height, .scale = 1.0f, .jobs = jobs };
+    raster->region = (SDL_Rect){ 0, 0, width, height };
+
+    raster->texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888,
+                                        SDL_TEXTUREACCESS_STREAMING, width, height);
+    if (!raster->texture) {
+        printf("No streaming texture for the CPU rasterizer: %s\n", SDL_GetError());
+        return false;
+    }
+    // The scene is opaque and covers the window, so nothing underneath shows
+    SDL_SetTextureBlendMode(raster->texture, SDL_BLENDMODE_NONE);
+    SDL_SetTextureScaleMode(raster->texture, SDL_ScaleModeLinear);
+    return true;
+}
+
+void raster_cleanup(Raster* raster) {
+    if (raster->texture) {
+        SDL_DestroyTexture(raster->texture);
+        raster->texture = NULL;
+    }
+    free(raster->commands);
+    free(raster->points);
+    raster->commands = NULL;
+    raster->points = NULL;
+    raster->max_commands = raster->max_points = 0;
+}
+
+void raster_begin(Raster* raster, float scale) {
+    raster->scale = scale;
+    raster->region = (SDL_Rect){ 0, 0, (int)lroundf(raster->width * scale),
+                                 (int)lroundf(raster->height * scale) };
+    raster->num_commands = 0;
+    raster->num_points = 0;
+}
+
+// Logical coordinate to texture pixels
+static inline int raster_scaled(const Raster* raster, int v) {
+    return raster->scale == 1.0f ? v : (int)floorf(v * raster->scale);
+}
+
+void raster_set_color(Raster* raster, uint8_t r, uint8_t g, uint8_t b, uint8_t a) {
+    raster->color = (uint32_t)a << 24 | (uint32_t)r << 16 | (uint32_t)g << 8 | b;
+}
+
+// Appends a command in the current color, or returns NULL if it would not
+// change any pixel of the region
+static RasterCommand* raster_push(Raster* raster, RasterOp op, int min_x, int min_y, int max_x, int max_y) {
+    if (op != RASTER_CLEAR && (raster->color >> 24) == 0) return NULL;
+    if (max_x < 0 || max_y < 0 || min_x >= raster->region.w || min_y >= raster->region.h) return NULL;
+
+    if (raster->num_commands == raster->max_commands) {
+        int capacity = raster->max_commands ? raster->max_commands * 2 : RASTER_INITIAL_COMMANDS;
+        RasterCommand* grown = realloc(raster->commands, sizeof(RasterCommand) * (size_t)capacity);
+        if (!grown) {
+            printf("CPU rasterizer out of memory at %d commands\n", raster->num_commands);
+            return NULL;
+        }
+        raster->commands = grown;
+        raster->max_commands = capacity;
+    }
+
+    RasterCommand* command = &raster->commands[raster->num_commands++];
+    command->op = op;
+    command->color = raster->color;
+    command->top = min_y;
+    command->bottom = max_y;
+    return command;
+}
+
+static void raster_push_line(Raster* raster, RasterOp op, int x0, int y0, int x1, int y1) {
+    x0 = raster_scaled(raster, x0);
+    y0 = raster_scaled(raster, y0);
+    x1 = raster_scaled(raster, x1);
+    y1 = raster_scaled(raster, y1);
+    RasterCommand* command = raster_push(raster, op, x0 < x1 ? x0 : x1, y0 < y1 ? y0 : y1,
+                                         x0 > x1 ? x0 : x1, y0 > y1 ? y0 : y1);
+    if (!command) return;
+    command->x0 = x0;
+    command->y0 = y0;
+    command->x1 = x1;
+    command->y1 = y1;
+}
+
+void raster_clear(Raster* raster) {
+    raster_push(raster, RASTER_CLEAR, 0, 0, raster->region.w - 1, raster->region.h - 1);
+}
+
+void raster_line(Raster* raster, int x0, int y0, int x1, int y1) {
+    raster_push_line(raster, RASTER_LINE, x0, y0, x1, y1);
+}
+
+// Like SDL's blended polylines, shared points are drawn once
+void raster_lines(Raster* raster, const SDL_Point* points, int count) {
+    for (int i = 0; i < count - 1; i++) {
+        RasterOp op = i == count - 2 ? RASTER_LINE : RASTER_LINE_OPEN;
+        raster_push_line(raster, op, points[i].x, points[i].y, points[i + 1].x, points[i + 1].y);
+    }
+}
+
+void raster_point(Raster* raster, int x, int y) {
+    raster_push_line(raster, RASTER_LINE, x, y, x, y);
+}
+
+void raster_fill_rect(Raster* raster, const SDL_Rect* rect) {
+    if (rect->w <= 0 || rect->h <= 0) return;
+    int x0 = raster_scaled(raster, rect->x);
+    int y0 = raster_scaled(raster, rect->y);
+    // At least a pixel each way, so small stars survive a low scale
+    int x1 = raster_scaled(raster, rect->x + rect->w) - 1;
+    int y1 = raster_scaled(raster, rect->y + rect->h) - 1;
+    if (x1 < x0) x1 = x0;
+    if (y1 < y0) y1 = y0;
+
+    RasterCommand* command = raster_push(raster, RASTER_RECT, x0, y0, x1, y1);
+    if (!command) return;
+    command->x0 = x0;
+    command->y0 = y0;
+    command->x1 = x1;
+    command->y1 = y1;
+}
+
+void raster_fill_polygon(Raster* raster, const SDL_Point* points, int count) {
+    if (count < 3) return;
+    if (raster->num_points + count > raster->max_points) {
+        int capacity = raster->max_points ? raster->max_points : RASTER_INITIAL_POINTS;
+        while (capacity < raster->num_points + count) capacity *= 2;
+        SDL_Point* grown = realloc(raster->points, sizeof(SDL_Point) * (size_t)capacity);
+        if (!grown) {
+            printf("CPU rasterizer out of memory at %d polygon points\n", raster->num_points);
+            return;
+        }
+        raster->points = grown;
+        raster->max_points = capacity;
+    }
+
+    SDL_Point* scaled = &raster->points[raster->num_points];
+    int min_x = INT32_MAX, min_y = INT32_MAX, max_x = INT32_MIN, max_y = INT32_MIN;
+    for (int i = 0; i < count; i++) {
+        scaled[i].x = raster_scaled(raster, points[i].x);
+        scaled[i].y = raster_scaled(raster, points[i].y);
+        if (scaled[i].x < min_x) min_x = scaled[i].x;
+        if (scaled[i].x > max_x) max_x = scaled[i].x;
+        if (scaled[i].y < min_y) min_y = scaled[i].y;
+        if (scaled[i].y > max_y) max_y = scaled[i].y;
+    }
+
+    RasterCommand* command = raster_push(raster, RASTER_POLYGON, min_x, min_y, max_x, max_y);
+    if (!command) return;
+    command->first = raster->num_points;
+    command->count = count;
+    raster->num_points += count;
+}
+
+// (s * a + d * (255 - a)) / 255, rounded; exact for every 8-bit input
+static inline uint32_t raster_blend_channel(uint32_t src, uint32_t dst, uint32_t a, int shift) {
+    uint32_t x = ((src >> shift) & 0xff) * a + ((dst >> shift) & 0xff) * (255 - a) + 128;
+    return ((x + (x >> 8)) >> 8) << shift;
+}
+
+static inline uint32_t raster_blend(uint32_t dst, uint32_t src) {
+    uint32_t a = src >> 24;
+    return 0xff000000 | raster_blend_channel(src, dst, a, 16) |
+           raster_blend_channel(src, dst, a, 8) | raster_blend_channel(src, dst, a, 0);
+}
+
+static inline void raster_plot(const RasterBand* band, int x, int y, uint32_t color) {
+    uint32_t* pixel = &band->pixels[y * band->pitch + x];
+    *pixel = (color >> 24) == 255 ? color : raster_blend(*pixel, color);
+}
+
+// Pixels [x0, x1] of one row, already clipped
+static void raster_span(uint32_t* row, int x0, int x1, uint32_t color) {
+    uint32_t* p = row + x0;
+    int n = x1 - x0 + 1;
+    int i = 0;
+    #ifdef __wasm_simd128__
+    if ((color >> 24) == 255) {
+        v128_t fill = wasm_i32x4_splat((int32_t)color);
+        for (; i + 4 <= n; i += 4) {
+            wasm_v128_store(p + i, fill);
+        }
+    } else {
+        // Channels widened to 16 bits, the same arithmetic as raster_blend
+        uint16_t a = (uint16_t)(color >> 24);
+        v128_t src = wasm_i16x8_add(wasm_i16x8_mul(wasm_u16x8_extend_low_u8x16(wasm_i32x4_splat((int32_t)color)),
+                                                   wasm_i16x8_splat(a)),
+                                    wasm_i16x8_splat(128));
+        v128_t inv = wasm_i16x8_splat(255 - a);
+        v128_t opaque = wasm_i32x4_splat((int32_t)0xff000000);
+        for (; i + 4 <= n; i += 4) {
+            v128_t dst = wasm_v128_load(p + i);
+            v128_t lo = wasm_i16x8_add(wasm_i16x8_mul(wasm_u16x8_extend_low_u8x16(dst), inv), src);
+            v128_t hi = wasm_i16x8_add(wasm_i16x8_mul(wasm_u16x8_extend_high_u8x16(dst), inv), src);
+            lo = wasm_u16x8_shr(wasm_i16x8_add(lo, wasm_u16x8_shr(lo, 8)), 8);
+            hi = wasm_u16x8_shr(wasm_i16x8_add(hi, wasm_u16x8_shr(hi, 8)), 8);
+            wasm_v128_store(p + i, wasm_v128_or(wasm_u8x16_narrow_i16x8(lo, hi), opaque));
+        }
+    }
+    #endif
+    if ((color >> 24) == 255) {
+        for (; i < n; i++) p[i] = color;
+    } else {
+        for (; i < n; i++) p[i] = raster_blend(p[i], color);
+    }
+}
+
+static void raster_band_span(const RasterBand* band, int y, int x0, int x1, uint32_t color) {
+    if (x0 < 0) x0 = 0;
+    if (x1 > band->width - 1) x1 = band->width - 1;
+    if (x0 > x1) return;
+    raster_span(&band->pixels[y * band->pitch], x0, x1, color);
+}
+
+// Narrows [*lo, *hi] to the steps i whose coordinate m0 + i * d / steps
+// (rounded) can fall in [min, max]. Rounding moves a coordinate's first step
+// by up to steps / 2|d|, so the range is widened by that; the plot loop
+// checks each pixel exactly.
+static void raster_clip_steps(int m0, int d, int steps, int min, int max, int* lo, int* hi) {
+    if (d == 0) {
+        if (m0 < min || m0 > max) *hi = -1;
+        return;
+    }
+    int64_t a = (int64_t)(min - m0) * steps / d;
+    int64_t b = (int64_t)(max - m0) * steps / d;
+    if (a > b) {
+        int64_t t = a;
+        a = b;
+        b = t;
+    }
+    int64_t margin = steps / (2 * (int64_t)abs(d)) + 1;
+    if (a - margin > *lo) *lo = (int)(a - margin);
+    if (b + margin < *hi) *hi = (int)(b + margin);
+}
+
+// Rounded i * d / n, halves away from zero
+static inline int raster_step(int i, int d, int n) {
+    int64_t twice = 2 * (int64_t)i * d;
+    return (int)((twice + (d < 0 ? -n : n)) / (2 * (int64_t)n));
+}
+
+// One pixel per step along the longer axis, like Bresenham, but each step is
+// computed directly so a band starts at its own first row
+static void raster_band_line(const RasterBand* band, const RasterCommand* command, bool open) {
+    int dx = command->x1 - command->x0;
+    int dy = command->y1 - command->y0;
+    int steps = abs(dx) > abs(dy) ? abs(dx) : abs(dy);
+    if (steps == 0) {
+        if (!open && command->y0 >= band->top && command->y0 < band->bottom &&
+            command->x0 >= 0 && command->x0 < band->width) {
+            raster_plot(band, command->x0, command->y0, command->color);
+        }
+        return;
+    }
+
+    int lo = 0, hi = open ? steps - 1 : steps;
+    raster_clip_steps(command->x0, dx, steps, 0, band->width - 1, &lo, &hi);
+    raster_clip_steps(command->y0, dy, steps, band->top, band->bottom - 1, &lo, &hi);
+    for (int i = lo; i <= hi; i++) {
+        int x = command->x0 + raster_step(i, dx, steps);
+        int y = command->y0 + raster_step(i, dy, steps);
+        if (x < 0 || x >= band->width || y < band->top || y >= band->bottom) continue;
+        raster_plot(band, x, y, command->color);
+    }
+}
+
+static void raster_band_polygon(const RasterBand* band, const Raster* raster, const RasterCommand* command) {
+    const SDL_Point* points = &raster->points[command->first];
+    int n = command->count;
+    int top = command->top > band->top ? command->top : band->top;
+    int bottom = command->bottom < band->bottom - 1 ? command->bottom : band->bottom - 1;
+
+    for (int y = top; y <= bottom; y++) {
+        int crossings[RASTER_MAX_POLYGON_EDGES];
+        int num_crossings = 0;
+        for (int i = 0; i < n && num_crossings < RASTER_MAX_POLYGON_EDGES; i++) {
+            const SDL_Point* a = &points[i];
+            const SDL_Point* b = &points[(i + 1) % n];
+            if (a->y == b->y) continue;
+            if ((a->y > y && b->y <= y) || (b->y > y && a->y <= y)) {
+                int x = a->x + (b->x - a->x) * (y - a->y) / (b->y - a->y);
+
+                // Insertion sort; a row crosses only a few edges
+                int j = num_crossings++;
+                while (j > 0 && crossings[j - 1] > x) {
+                    crossings[j] = crossings[j - 1];
+                    j--;
+                }
+                crossings[j] = x;
+            }
+        }
+        for (int i = 0; i < num_crossings - 1; i += 2) {
+            raster_band_span(band, y, crossings[i], crossings[i + 1], command->color);
+        }
+    }
+}
+
+static void raster_band_range(void* arg, int begin, int end) {
+    const Raster* raster = (const Raster*)arg;
+    for (int b = begin; b < end; b++) {
+        RasterBand band = {
+            .pixels = raster->pixels,
+            .pitch = raster->pitch,
+            .width = raster->region.w,
+            .top = b * RASTER_BAND_ROWS,
+            .bottom = (b + 1) * RASTER_BAND_ROWS < raster->region.h ? (b + 1) * RASTER_BAND_ROWS : raster->region.h
+        };
+
+        // Every band replays the whole list in order, so overlaps blend as drawn
+        for (int i = 0; i < raster->num_commands; i++) {
+            const RasterCommand* command = &raster->commands[i];
+            if (command->bottom < band.top || command->top >= band.bottom) continue;
+
+            switch (command->op) {
+                case RASTER_CLEAR:
+                    // Clearing ignores blending, as SDL_RenderClear does
+                    for (int y = band.top; y < band.bottom; y++) {
+                        raster_span(&band.pixels[y * band.pitch], 0, band.width - 1, command->color | 0xff000000);
+                    }
+                    break;
+                case RASTER_LINE:
+                case RASTER_LINE_OPEN:
+                    raster_band_line(&band, command, command->op == RASTER_LINE_OPEN);
+                    break;
+                case RASTER_RECT: {
+                    int top = command->y0 > band.top ? command->y0 : band.top;
+                    int bottom = command->y1 < band.bottom - 1 ? command->y1 : band.bottom - 1;
+                    for (int y = top; y <= bottom; y++) {
+                        raster_band_span(&band, y, command->x0, command->x1, command->color);
+                    }
+                    break;
+                }
+                case RASTER_POLYGON:
+                    raster_band_polygon(&band, raster, command);
+                    break;
+            }
+        }
+    }
+}
+
+void raster_render(Raster* raster) {
+    if (!raster->texture || raster->region.w <= 0 || raster->region.h <= 0) return;
+
+    void* pixels;
+    int pitch;
+    if (SDL_LockTexture(raster->texture, &raster->region, &pixels, &pitch) != 0) {
+        printf("Failed to lock the raster texture: %s\n", SDL_GetError());
+        return;
+    }
+    raster->pixels = (uint32_t*)pixels;
+    raster->pitch = pitch / (int)sizeof(uint32_t);
+
+    int bands = (raster->region.h + RASTER_BAND_ROWS - 1) / RASTER_BAND_ROWS;
+    jobs_parallel_for(raster->jobs, bands, 1, raster_band_range, raster);
+
+    SDL_UnlockTexture(raster->texture);
+    raster->pixels = NULL;
+}
+
+void raster_present(Raster* raster, SDL_Renderer* renderer) {
+    if (!raster->texture) return;
+    SDL_RenderCopy(renderer, raster->texture, &raster->region, NULL);
+}
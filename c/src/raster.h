@@ -0,0 +1,72 @@
+#ifndef RASTER_H
+#define RASTER_H
+
+#include <SDL.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include "jobs.h"
+
+#define RASTER_BAND_ROWS 32          // rows per job when rasterizing
+#define RASTER_MAX_POLYGON_EDGES 64  // scanline crossings kept per row
+
+typedef enum {
+    RASTER_CLEAR,
+    RASTER_LINE,         // both end points
+    RASTER_LINE_OPEN,    // without the end point, for joined polylines
+    RASTER_RECT,
+    RASTER_POLYGON
+} RasterOp;
+
+typedef struct {
+    RasterOp op;
+    uint32_t color;      // ARGB8888
+    int top, bottom;     // rows touched, to skip bands quickly
+    int x0, y0, x1, y1;  // line ends or inclusive rect corners
+    int first, count;    // polygon points in Raster.points
+} RasterCommand;
+
+// CPU rasterizer for the vector-art scene, in place of one SDL draw call per
+// line. Drawing only records commands (with the dynamic resolution scale
+// applied); raster_render rasterizes them into a locked streaming texture,
+// one band of rows per job, and raster_present puts the texture on screen
+// with a single SDL_RenderCopy. Blending matches SDL_BLENDMODE_BLEND on an
+// opaque target.
+typedef struct {
+    SDL_Texture* texture;       // streaming, logical size; NULL if unavailable
+    int width, height;          // logical size
+    float scale;                // logical to texture pixels, from raster_begin
+    SDL_Rect region;            // part of the texture the scene covers
+    uint32_t color;             // current draw color
+    RasterCommand* commands;
+    int num_commands, max_commands;
+    SDL_Point* points;          // polygon vertices, already scaled
+    int num_points, max_points;
+    JobSystem* jobs;            // band workers; NULL runs inline
+    uint32_t* pixels;           // the locked region while rasterizing
+    int pitch;                  // in pixels
+} Raster;
+
+bool raster_init(Raster* raster, SDL_Renderer* renderer, JobSystem* jobs, int width, int height);
+void raster_cleanup(Raster* raster);
+
+// Starts recording a frame drawn at scale times the logical size
+void raster_begin(Raster* raster, float scale);
+
+// Same arguments as the SDL draw calls they replace
+void raster_set_color(Raster* raster, uint8_t r, uint8_t g, uint8_t b, uint8_t a);
+void raster_clear(Raster* raster);
+void raster_line(Raster* raster, int x0, int y0, int x1, int y1);
+void raster_lines(Raster* raster, const SDL_Point* points, int count);
+void raster_point(Raster* raster, int x, int y);
+void raster_fill_rect(Raster* raster, const SDL_Rect* rect);
+// Even-odd scanline fill, the same spans as fill_polygon (src/player.h)
+void raster_fill_polygon(Raster* raster, const SDL_Point* points, int count);
+
+// Rasterizes the recorded frame into the texture. Locked texture memory is
+// not kept between frames, so every frame starts with raster_clear.
+void raster_render(Raster* raster);
+
+// Copies the scene over the whole render target, stretched if below scale 1
+void raster_present(Raster* raster, SDL_Renderer* renderer);
+
+#endif // RASTER_H
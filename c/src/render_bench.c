@@ -0,0 +1,277 @@
+// Headless render benchmark: draws scripted games through renderer_draw_frame
+// on SDL's software renderer, with no window or GPU, and prints the time
+// spent in each part of the frame (RenderProfile). Animation runs off a fixed
+// clock, so the same arguments always produce the same pixels; --ppm writes
+// frames out and --golden compares them against a directory written earlier.
+//
+//   f22_render_bench --frames 300 --ppm out/ --every 60
+//   f22_render_bench --golden out/ --every 60
+#include "game_state.h"
+#include "renderer.h"
+#include "frame.h"
+#include "pack.h"
+#include "sim.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define BENCH_SEED 0x5eed
+#define BENCH_TICK (1.0f / SIM_TICK_RATE)
+#define BENCH_TICK_MS (1000 / SIM_TICK_RATE)
+#define BENCH_EXPLOSION_AFTER 30   // ticks of flight before the forced crash
+
+typedef struct {
+    int frames;
+    int quality;               // -1 adapts as in the game
+    float scale;               // 0 adapts as in the game
+    const char* ppm_dir;
+    const char* golden_dir;
+    int every;                 // snapshot interval in frames
+    int tolerance;             // per-channel difference still accepted
+    bool raster;               // CPU rasterizer instead of SDL draw calls
+} BenchOptions;
+
+typedef enum {
+    SCENARIO_MENU,             // waiting screen, asteroids drifting
+    SCENARIO_FLIGHT,           // autopilot following the ghost path
+    SCENARIO_EXPLOSION,        // crash, debris and the end-of-game wave
+    SCENARIO_COUNT
+} Scenario;
+
+static const char* SCENARIO_NAMES[SCENARIO_COUNT] = { "menu", "flight", "explosion" };
+
+static const char* STAGE_NAMES[RENDER_STAGE_COUNT] = {
+    "backgrnd", "wave", "asteroid", "barrier", "player", "explode", "raster", "upscale", "hud", "capture", "present"
+};
+
+static GameState g_state;
+static RenderFrame g_frame;
+
+// Thrusts whenever the player is below the ghost path under it
+static bool autopilot(const GameState* state) {
+    int column = (int)f22_to_float(state->player.position.x);
+    if (column < 0) column = 0;
+    if (column >= WINDOW_WIDTH) column = WINDOW_WIDTH - 1;
+    return state->player.position.y.value > state->wave.points[column].y.value;
+}
+
+static bool scenario_step(Scenario scenario, GameState* state, int frame) {
+    bool thrust = false;
+    switch (scenario) {
+        case SCENARIO_MENU:
+            break;
+        case SCENARIO_FLIGHT:
+            thrust = autopilot(state);
+            break;
+        case SCENARIO_EXPLOSION:
+            thrust = autopilot(state);
+            if (frame == BENCH_EXPLOSION_AFTER && state->state == GAME_STATE_PLAYING) {
+                state->state = GAME_STATE_OVER;
+                explosion_start(&state->explosion, &state->player);
+            }
+            break;
+        default:
+            break;
+    }
+    game_state_update(state, thrust, BENCH_TICK);
+    game_state_check_collisions(state);
+    return thrust;
+}
+
+static void pixel_rgb(const SDL_Surface* surface, int x, int y, uint8_t rgb[3]) {
+    const uint32_t* row = (const uint32_t*)((const uint8_t*)surface->pixels + (size_t)y * surface->pitch);
+    SDL_GetRGB(row[x], surface->format, &rgb[0], &rgb[1], &rgb[2]);
+}
+
+static bool write_ppm(const char* path, const SDL_Surface* surface) {
+    FILE* file = fopen(path, "wb");
+    if (!file) {
+        printf("Cannot write %s\n", path);
+        return false;
+    }
+    fprintf(file, "P6\n%d %d\n255\n", surface->w, surface->h);
+    for (int y = 0; y < surface->h; y++) {
+        for (int x = 0; x < surface->w; x++) {
+            uint8_t rgb[3];
+            pixel_rgb(surface, x, y, rgb);
+            fwrite(rgb, 1, 3, file);
+        }
+    }
+    fclose(file);
+    return true;
+}
+
+// Returns the number of pixels that differ by more than tolerance in any
+// channel, or -1 if the golden image is missing or has another size
+static long compare_ppm(const char* path, const SDL_Surface* surface, int tolerance, int* max_diff) {
+    FILE* file = fopen(path, "rb");
+    if (!file) return -1;
+
+    int width, height, maxval;
+    if (fscanf(file, "P6 %d %d %d", &width, &height, &maxval) != 3 ||
+        width != surface->w || height != surface->h || maxval != 255) {
+        fclose(file);
+        return -1;
+    }
+    fgetc(file);   // the single whitespace after the header
+
+    long differing = 0;
+    for (int y = 0; y < surface->h; y++) {
+        for (int x = 0; x < surface->w; x++) {
+            uint8_t golden[3], rgb[3];
+            if (fread(golden, 1, 3, file) != 3) {
+                fclose(file);
+                return -1;
+            }
+            pixel_rgb(surface, x, y, rgb);
+            int worst = 0;
+            for (int c = 0; c < 3; c++) {
+                int diff = abs(rgb[c] - golden[c]);
+                if (diff > worst) worst = diff;
+            }
+            if (worst > *max_diff) *max_diff = worst;
+            if (worst > tolerance) differing++;
+        }
+    }
+    fclose(file);
+    return differing;
+}
+
+static void print_profile(const char* name, const RenderProfile* profile) {
+    double total = 0;
+    printf("%-10s", name);
+    for (int i = 0; i < RENDER_STAGE_COUNT; i++) {
+        double ms = profile->ms[i] / profile->frames;
+        total += ms;
+        printf(" %8.3f", ms);
+    }
+    printf(" %8.3f\n", total);
+}
+
+// Returns the number of snapshots that failed the golden comparison
+static int run_scenario(Scenario scenario, Renderer* renderer, SDL_Surface* surface,
+                        const BenchOptions* options, uint32_t* clock) {
+    g_state = game_state_create(BENCH_SEED);
+    g_state.jobs = renderer->jobs;
+    if (scenario != SCENARIO_MENU) game_state_start(&g_state);
+
+    RenderProfile profile = {0};
+    renderer->profile = &profile;
+    int failures = 0;
+
+    for (int frame = 0; frame < options->frames; frame++) {
+        bool thrust = scenario_step(scenario, &g_state, frame);
+        frame_capture(&g_frame, &g_state, thrust);
+        renderer->clock_ticks = *clock;
+        *clock += BENCH_TICK_MS;
+        renderer_draw_frame(renderer, &g_frame);
+
+        if (frame % options->every != options->every - 1) continue;
+        char path[1024];
+        if (options->ppm_dir) {
+            snprintf(path, sizeof(path), "%s/%s_%04d.ppm", options->ppm_dir, SCENARIO_NAMES[scenario], frame + 1);
+            write_ppm(path, surface);
+        }
+        if (options->golden_dir) {
+            snprintf(path, sizeof(path), "%s/%s_%04d.ppm", options->golden_dir, SCENARIO_NAMES[scenario], frame + 1);
+            int max_diff = 0;
+            long differing = compare_ppm(path, surface, options->tolerance, &max_diff);
+            if (differing != 0) {
+                failures++;
+                if (differing < 0) {
+                    printf("  %s: no usable golden image\n", path);
+                } else {
+                    printf("  %s: %ld pixels differ (max %d)\n", path, differing, max_diff);
+                }
+            }
+        }
+    }
+
+    renderer->profile = NULL;
+    print_profile(SCENARIO_NAMES[scenario], &profile);
+    return failures;
+}
+
+static void usage(void) {
+    printf("usage: f22_render_bench [--frames N] [--quality LEVEL] [--scale S] [--raster 0|1]\n"
+           "                        [--ppm DIR] [--golden DIR] [--every N] [--tolerance N]\n"
+           "--quality -1 and --scale 0 adapt to the frame time as the game does\n");
+}
+
+int main(int argc, char* argv[]) {
+    BenchOptions options = { .frames = 300, .quality = 0, .scale = 1.0f, .every = 60 };
+    for (int i = 1; i < argc; i++) {
+        const char* value = i + 1 < argc ? argv[i + 1] : NULL;
+        if (!value) {
+            usage();
+            return 1;
+        }
+        if (strcmp(argv[i], "--frames") == 0) options.frames = atoi(value);
+        else if (strcmp(argv[i], "--quality") == 0) options.quality = atoi(value);
+        else if (strcmp(argv[i], "--scale") == 0) options.scale = (float)atof(value);
+        else if (strcmp(argv[i], "--ppm") == 0) options.ppm_dir = value;
+        else if (strcmp(argv[i], "--golden") == 0) options.golden_dir = value;
+        else if (strcmp(argv[i], "--every") == 0) options.every = atoi(value);
+        else if (strcmp(argv[i], "--tolerance") == 0) options.tolerance = atoi(value);
+        else if (strcmp(argv[i], "--raster") == 0) options.raster = atoi(value) != 0;
+        else {
+            usage();
+            return 1;
+        }
+        i++;
+    }
+    if (options.frames < 1) options.frames = 1;
+    if (options.every < 1) options.every = 1;
+
+    if (SDL_Init(0) < 0) {
+        printf("SDL_Init failed: %s\n", SDL_GetError());
+        return 1;
+    }
+
+    // The HUD font comes from the pack, as in the game
+    char* base_path = SDL_GetBasePath();
+    char pack_path[1024];
+    snprintf(pack_path, sizeof(pack_path), "%sassets.pak", base_path ? base_path : "");
+    SDL_free(base_path);
+    pack_open(pack_path);
+
+    SDL_Surface* surface = SDL_CreateRGBSurfaceWithFormat(0, WINDOW_WIDTH, WINDOW_HEIGHT, 32, SDL_PIXELFORMAT_ARGB8888);
+    JobSystem* jobs = jobs_create(-1);
+    static Renderer renderer;
+    if (!surface || renderer_init_headless(&renderer, jobs, BENCH_SEED, surface) < 0) {
+        printf("Software renderer failed: %s\n", SDL_GetError());
+        return 1;
+    }
+
+    // Everything that adapts to timing is fixed, so frames are reproducible
+    renderer.clock_fixed = true;
+    renderer.hud.show_fps = false;
+    options.raster = renderer_use_raster(&renderer, options.raster);
+    if (options.quality >= 0) options.quality = quality_set_level(&renderer.quality, options.quality);
+    if (options.scale > 0.0f) dynres_set_scale(&renderer.dynres, options.scale);
+
+    printf("%d frames per scenario, quality %d, scale %d%%, %s\n", options.frames, options.quality,
+           (int)(renderer.dynres.scale * 100.0f + 0.5f), options.raster ? "CPU raster" : "SDL draw calls");
+    printf("%-10s", "ms/frame");
+    for (int i = 0; i < RENDER_STAGE_COUNT; i++) {
+        printf(" %8s", STAGE_NAMES[i]);
+    }
+    printf(" %8s\n", "total");
+
+    uint32_t clock = 1000;
+    int failures = 0;
+    for (int scenario = 0; scenario < SCENARIO_COUNT; scenario++) {
+        failures += run_scenario((Scenario)scenario, &renderer, surface, &options, &clock);
+    }
+    if (options.golden_dir) {
+        if (failures) printf("%d snapshots differ from %s\n", failures, options.golden_dir);
+        else printf("All snapshots match %s\n", options.golden_dir);
+    }
+
+    renderer_cleanup(&renderer);
+    SDL_FreeSurface(surface);
+    jobs_destroy(jobs);
+    pack_close();
+    SDL_Quit();
+    return failures ? 1 : 0;
+}
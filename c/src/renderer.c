@@ -7,7 +7,32 @@
 #include <emscripten.h>
 #endif
 
-int renderer_init(Renderer* renderer) {
+// Everything after the SDL renderer exists, shared by both init paths
+static int renderer_setup(Renderer* renderer, JobSystem* jobs, uint64_t seed) {
+    if (!renderer->renderer) return -1;
+
+    renderer->last_particle_spawn = SDL_GetTicks();
+    renderer->jobs = jobs;
+    renderer->canvas = (Canvas){ .sdl = renderer->renderer };
+    renderer->rng = rng_init(seed, RNG_STREAM_RENDER);
+    renderer->background = background_init(renderer->renderer, seed);
+
+    SDL_RendererInfo info;
+    SDL_GetRendererInfo(renderer->renderer, &info);
+    printf("RENDERER INFO: name=%s, flags=%d\n", info.name, info.flags);
+    renderer_init_shapes(renderer);
+    SDL_SetRenderDrawBlendMode(renderer->renderer, SDL_BLENDMODE_BLEND);
+    hud_init(&renderer->hud);
+    dynres_init(&renderer->dynres, renderer->renderer, WINDOW_WIDTH, WINDOW_HEIGHT);
+    quality_init(&renderer->quality);
+    #ifdef F22_CPU_RASTER
+    renderer_use_raster(renderer, true);
+    #endif
+
+    return 0;
+}
+
+int renderer_init(Renderer* renderer, JobSystem* jobs, uint64_t seed) {
     #ifdef __EMSCRIPTEN__
     SDL_CreateWindowAndRenderer(WINDOW_WIDTH, WINDOW_HEIGHT, SDL_WINDOW_SHOWN,
                               &renderer->window, &renderer->renderer);
@@ -21,28 +46,32 @@ int renderer_init(Renderer* renderer) {
                                           SDL_RENDERER_ACCELERATED);
     #endif
 
-    if (!renderer->renderer) return -1;
-
-    renderer->last_particle_spawn = SDL_GetTicks();
-    renderer->background = background_init(renderer->renderer);
+    return renderer_setup(renderer, jobs, seed);
+}
 
-    SDL_RendererInfo info;
-    SDL_GetRendererInfo(renderer->renderer, &info);
-    printf("RENDERER INFO: name=%s, flags=%d\n", info.name, info.flags);
-    renderer_init_shapes(renderer);
-    SDL_SetRenderDrawBlendMode(renderer->renderer, SDL_BLENDMODE_BLEND);
-    // if (TTF_Init() == -1) {
-    //     printf("SDL_ttf could not initialize! Error: %s\n", TTF_GetError());
-    //     return -1;
-    // }
+int renderer_init_headless(Renderer* renderer, JobSystem* jobs, uint64_t seed, SDL_Surface* surface) {
+    renderer->window = NULL;
+    renderer->renderer = SDL_CreateSoftwareRenderer(surface);
+    return renderer_setup(renderer, jobs, seed);
+}
 
-    // renderer_init_font(renderer, "/assets/vt323.ttf", 24);
+// Animation time in ms; a fixed clock makes headless frames reproducible
+static uint32_t renderer_ticks(const Renderer* renderer) {
+    return renderer->clock_fixed ? renderer->clock_ticks : SDL_GetTicks();
+}
 
-    return 0;
+// Adds the time since the previous mark to stage
+static void renderer_profile_mark(Renderer* renderer, RenderStage stage) {
+    RenderProfile* profile = renderer->profile;
+    if (!profile) return;
+    uint64_t now = SDL_GetPerformanceCounter();
+    profile->ms[stage] += (now - profile->mark) * 1000.0 / SDL_GetPerformanceFrequency();
+    profile->mark = now;
 }
 
-Background* background_init(SDL_Renderer* renderer) {
+Background* background_init(SDL_Renderer* renderer, uint64_t seed) {
     static Background bg;
+    bg.rng = rng_init(seed, RNG_STREAM_BACKGROUND);
     
     // Create a texture the size of our window
     bg.star_texture = SDL_CreateTexture(renderer,
@@ -51,18 +80,19 @@ Background* background_init(SDL_Renderer* renderer) {
         WINDOW_WIDTH, WINDOW_HEIGHT);
     
     // Set initial star positions
-    for(int i = 0; i < 50; i++) {
+    bg.star_count = BACKGROUND_STARS;
+    for(int i = 0; i < BACKGROUND_STARS; i++) {
         bg.stars[i] = (Star){
-            .x = rand() % WINDOW_WIDTH,
-            .y = rand() % WINDOW_HEIGHT,
-            .size = 1 + (rand() % 5),
-            .speed = 1 + (rand() % 2),
-            .brightness = 150 + (rand() % 100)
+            .x = rng_range(&bg.rng, WINDOW_WIDTH),
+            .y = rng_range(&bg.rng, WINDOW_HEIGHT),
+            .size = 1 + rng_range(&bg.rng, 5),
+            .speed = 1 + rng_range(&bg.rng, 2),
+            .brightness = 150 + rng_range(&bg.rng, 100)
         };
     }
     
-    // Draw initial star positions to texture
-    update_star_texture(renderer, &bg);
+    // The texture is filled on the first frame so init returns right away
+    bg.star_texture_ready = false;
     
     bg.gradient_opacity = 0;
     bg.gradient_direction = 1;
@@ -70,30 +100,30 @@ Background* background_init(SDL_Renderer* renderer) {
     return &bg;
 }
 
-void update_star_texture(SDL_Renderer* renderer, Background* bg) {
-    // Switch render target to our texture
-    SDL_SetRenderTarget(renderer, bg->star_texture);
-    
-    // Clear the texture
-    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 0);
-    SDL_RenderClear(renderer);
-    
-    // Draw all stars to the texture
-    for(int i = 0; i < 50; i++) {
-        int _rand = rand() % 2;
+// Picks each star's color until the next refresh
+static void pick_star_colors(Background* bg) {
+    for(int i = 0; i < bg->star_count; i++) {
+        int _rand = rng_range(&bg->rng, 2);
         if (_rand == 0) {
-            SDL_SetRenderDrawColor(renderer, 
+            bg->stars[i].color = (SDL_Color){
                 bg->stars[i].brightness,
                 bg->stars[i].brightness,
                 bg->stars[i].brightness,
-                255);
+                255};
         } else {
-            SDL_SetRenderDrawColor(renderer, 
+            bg->stars[i].color = (SDL_Color){
                 bg->stars[i].brightness,
                 bg->stars[i].brightness / 5,
                 255,
-                255);
+                255};
         }
+    }
+}
+
+static void draw_stars(const Canvas* canvas, const Background* bg) {
+    for(int i = 0; i < bg->star_count; i++) {
+        SDL_Color c = bg->stars[i].color;
+        canvas_color(canvas, c.r, c.g, c.b, c.a);
             
         if(bg->stars[i].size > 1) {
             SDL_Rect star = {
@@ -101,35 +131,84 @@ void update_star_texture(SDL_Renderer* renderer, Background* bg) {
                 (int)bg->stars[i].y,
                 2, 2
             };
-            SDL_RenderFillRect(renderer, &star);
+            canvas_fill_rect(canvas, &star);
         } else {
-            SDL_RenderDrawPoint(renderer,
+            canvas_point(canvas,
                 (int)bg->stars[i].x,
                 (int)bg->stars[i].y);
         }
     }
+}
+
+void update_star_texture(SDL_Renderer* renderer, Background* bg) {
+    // The scene may be going to the dynamic resolution target; switching
+    // targets resets the scale and viewport, so keep them to restore
+    SDL_Texture* previous = SDL_GetRenderTarget(renderer);
+    SDL_Rect viewport;
+    float scale_x, scale_y;
+    SDL_RenderGetScale(renderer, &scale_x, &scale_y);
+    SDL_RenderGetViewport(renderer, &viewport);
+
+    // Switch render target to our texture
+    SDL_SetRenderTarget(renderer, bg->star_texture);
+    
+    // Clear the texture
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 0);
+    SDL_RenderClear(renderer);
+    
+    // Draw the stars to the texture
+    pick_star_colors(bg);
+    draw_stars(&(Canvas){ .sdl = renderer }, bg);
     
-    // Switch back to default render target
-    SDL_SetRenderTarget(renderer, NULL);
+    // Switch back to the previous render target
+    SDL_SetRenderTarget(renderer, previous);
+    if (previous) {
+        SDL_RenderSetScale(renderer, scale_x, scale_y);
+        SDL_RenderSetViewport(renderer, &viewport);
+    }
+}
+
+#define STAR_GRAIN 16
+
+typedef struct {
+    Background* bg;
+    float player_movement;
+} StarJob;
+
+static void move_star_range(void* arg, int begin, int end) {
+    StarJob* job = (StarJob*)arg;
+    for(int i = begin; i < end; i++) {
+        // Base movement plus player influence
+        float total_speed = fmaxf(-0.1f, job->bg->stars[i].speed + job->player_movement);
+        job->bg->stars[i].x -= total_speed;
+    }
 }
 
-void draw_background(SDL_Renderer* renderer, Background* bg, const GameState* state) {
+// The SDL path keeps the stars in a texture; the rasterizer draws them every
+// frame, so a refresh only picks new colors
+static void refresh_stars(const Canvas* canvas, Background* bg) {
+    if (canvas->raster) pick_star_colors(bg);
+    else update_star_texture(canvas->sdl, bg);
+    bg->star_texture_ready = true;
+}
+
+void draw_background(const Canvas* canvas, Background* bg, JobSystem* jobs, const RenderFrame* frame) {
     uint32_t current_time = SDL_GetTicks();
     float delta = (current_time - bg->last_frame) / 1000.0f;
     bg->last_frame = current_time;
 
     // Don't update stars if game is over
-    if (state->state != GAME_STATE_OVER) {
+    if (frame->state != GAME_STATE_OVER) {
         static int update_counter = 0;
         if(++update_counter >= 3) {
             // Calculate player's movement influence
-            float player_x = f22_to_float(state->player.position.x);
+            float player_x = f22_to_float(frame->player.position.x);
             float player_movement = 0.0f;
             
             if (player_x < WINDOW_WIDTH / 2.0f) {
                 // Calculate normalized distance from ghost path
-                float ghost_y = f22_to_float(state->wave.points[(int)player_x].y);
-                float player_y = f22_to_float(state->player.position.y);
+                float ghost_y = f22_to_float(frame->wave[(int)player_x].y);
+                float player_y = f22_to_float(frame->player.position.y);
                 float y_distance = fabsf(ghost_y - player_y) / WINDOW_HEIGHT;
                 
                 // Player moves faster left when far from path, and right when close
@@ -137,43 +216,54 @@ void draw_background(SDL_Renderer* renderer, Background* bg, const GameState* st
             }
             
             // Update star positions with combined movement
-            for(int i = 0; i < 50; i++) {
-                // Base movement plus player influence
-                float total_speed = fmaxf(-0.1f, bg->stars[i].speed + player_movement);
-                bg->stars[i].x -= total_speed;
-                
+            StarJob job = { bg, player_movement };
+            jobs_parallel_for(jobs, BACKGROUND_STARS, STAR_GRAIN, move_star_range, &job);
+
+            // Respawn pulls from the background rng, so keep it in order
+            for(int i = 0; i < BACKGROUND_STARS; i++) {
                 if(bg->stars[i].x < 0) {
                     bg->stars[i].x = WINDOW_WIDTH;
-                    bg->stars[i].y = rand() % WINDOW_HEIGHT;
+                    bg->stars[i].y = rng_range(&bg->rng, WINDOW_HEIGHT);
                 }
             }
-            update_star_texture(renderer, bg);
+            refresh_stars(canvas, bg);
             update_counter = 0;
         }
     }
+    if (!bg->star_texture_ready) {
+        refresh_stars(canvas, bg);
+    }
     
     // Draw gradient background
     SDL_Rect bg_rect = {0, 0, WINDOW_WIDTH, WINDOW_HEIGHT};
     uint8_t alpha = (uint8_t)(bg->gradient_opacity * 25);
-    SDL_SetRenderDrawColor(renderer, 20, 15, 35, alpha);
-    SDL_RenderFillRect(renderer, &bg_rect);
+    canvas_color(canvas, 20, 15, 35, alpha);
+    canvas_fill_rect(canvas, &bg_rect);
     
     // Draw star texture
-    SDL_RenderCopy(renderer, bg->star_texture, NULL, NULL);
+    if (canvas->raster) draw_stars(canvas, bg);
+    else SDL_RenderCopy(canvas->sdl, bg->star_texture, NULL, NULL);
 }
 
 void renderer_cleanup(Renderer* renderer) {
-    SDL_DestroyRenderer(renderer->renderer);
-    SDL_DestroyWindow(renderer->window);
+    hud_cleanup(&renderer->hud);
+    raster_cleanup(&renderer->raster);
+    dynres_cleanup(&renderer->dynres);
+    // background_init returns static storage, so only its texture is freed
     if (renderer->background) {
         SDL_DestroyTexture(renderer->background->star_texture);
-        free(renderer->background);
     }
+    SDL_DestroyRenderer(renderer->renderer);
+    if (renderer->window) SDL_DestroyWindow(renderer->window);
 }
 
-void renderer_draw_score(Renderer* renderer, uint32_t score) {
-    // char score_text[32];
-    // snprintf(score_text, sizeof(score_text), "SCORE: %d", (int)scoring->score);
+bool renderer_use_raster(Renderer* renderer, bool enable) {
+    if (enable && !renderer->raster.texture &&
+        !raster_init(&renderer->raster, renderer->renderer, renderer->jobs, WINDOW_WIDTH, WINDOW_HEIGHT)) {
+        enable = false;
+    }
+    renderer->canvas.raster = enable ? &renderer->raster : NULL;
+    return enable;
 }
 
 void renderer_init_shapes(Renderer* renderer) {
@@ -289,8 +379,8 @@ void renderer_init_shapes(Renderer* renderer) {
     
 //     renderer->num_wave_points = 0;
 //     for (int i = 0; i < WINDOW_WIDTH; i++) {
-//         if (wave->points[i].activated) {
-//             ScreenPos base_pos = world_to_screen(wave->points[i].x, wave->points[i].y, camera_y_offset);
+//         if (wave[i].activated) {
+//             ScreenPos base_pos = world_to_screen(wave[i].x, wave[i].y, camera_y_offset);
             
 //             // Phase offset based on x position creates the moving spiral
 //             float phase = i * frequency + time * wave_speed;
@@ -331,29 +421,46 @@ float smooth_noise(float y, float time, float frequency, float camera_offset) {
            sinf(y_offset * 2.3f - t_offset * 0.8f) * 0.1f;
 }
 
-void renderer_draw_barrier(SDL_Renderer* renderer, float time, F22 camera_y_offset) {
-    const int NUM_POINTS = 200;  // number of points per line
+#define BARRIER_POINTS 200  // most points per line (QualitySettings.barrier_points)
+#define BARRIER_GRAIN 50
+
+typedef struct {
+    SDL_Point* line1;
+    SDL_Point* line2;
+    int num_points;
+    float time;
+    float camera_y;
+} BarrierJob;
+
+static void barrier_noise_range(void* arg, int begin, int end) {
+    BarrierJob* job = (BarrierJob*)arg;
     const int BASE_X = GAME_OVER_X - 20;  // base x position for both lines
     const int LINE_SPACING = 25;  // space between the two lines
-    SDL_Point line1[NUM_POINTS];
-    SDL_Point line2[NUM_POINTS];
-    
+
     // Generate points for both lines with smooth noise offsets
-    for(int i = 0; i < NUM_POINTS; i++) {
-        float y = (float)i * WINDOW_HEIGHT / (NUM_POINTS - 1);
+    for(int i = begin; i < end; i++) {
+        float y = (float)i * WINDOW_HEIGHT / (job->num_points - 1);
         
         // Calculate noise offsets for each line
-        float camera_y = f22_to_float(camera_y_offset);
-        float noise1 = smooth_noise(y, time, 0.03f, camera_y) * 50.0f;
-        float noise2 = smooth_noise(y, time + 100.0f, 0.03f, camera_y) * 50.0f;
+        float noise1 = smooth_noise(y, job->time, 0.03f, job->camera_y) * 50.0f;
+        float noise2 = smooth_noise(y, job->time + 100.0f, 0.03f, job->camera_y) * 50.0f;
         
         // Set points with noise offset
-        line1[i].x = BASE_X + (int)noise1;
-        line1[i].y = (int)y;
+        job->line1[i].x = BASE_X + (int)noise1;
+        job->line1[i].y = (int)y;
         
-        line2[i].x = BASE_X + LINE_SPACING + (int)noise2;
-        line2[i].y = (int)y;
+        job->line2[i].x = BASE_X + LINE_SPACING + (int)noise2;
+        job->line2[i].y = (int)y;
     }
+}
+
+void renderer_draw_barrier(const Canvas* canvas, JobSystem* jobs, float time, F22 camera_y_offset, int num_points) {
+    const int NUM_POINTS = num_points < 2 ? 2 : num_points > BARRIER_POINTS ? BARRIER_POINTS : num_points;
+    SDL_Point line1[BARRIER_POINTS];
+    SDL_Point line2[BARRIER_POINTS];
+    
+    BarrierJob job = { line1, line2, NUM_POINTS, time, f22_to_float(camera_y_offset) };
+    jobs_parallel_for(jobs, NUM_POINTS, BARRIER_GRAIN, barrier_noise_range, &job);
     
     // Draw the lines with the wave color scheme
     for(int i = 0; i < NUM_POINTS - 1; i++) {
@@ -363,13 +470,13 @@ void renderer_draw_barrier(SDL_Renderer* renderer, float time, F22 camera_y_offs
         uint8_t g = lerp(255, 0, height_factor);
         uint8_t b = 255;
         
-        SDL_SetRenderDrawColor(renderer, r, g, b, 255);
+        canvas_color(canvas, r, g, b, 255);
         
         // Draw line segments
-        SDL_RenderDrawLine(renderer, 
+        canvas_line(canvas, 
             line1[i].x, line1[i].y, 
             line1[i+1].x, line1[i+1].y);
-        SDL_RenderDrawLine(renderer, 
+        canvas_line(canvas, 
             line2[i].x, line2[i].y, 
             line2[i+1].x, line2[i+1].y);
             
@@ -382,145 +489,54 @@ void renderer_draw_barrier(SDL_Renderer* renderer, float time, F22 camera_y_offs
         // }
     }
 }
-void renderer_end_wave(Renderer* renderer, const WaveGenerator* wave, const Player* player, F22 camera_y_offset) {
-    float time = SDL_GetTicks() / 1000.0f;
-    float wave_speed = 2.0f;
-    float max_amplitude = 25.0f;
-    float frequency = 0.06f;
-    
-    // Get player position in screen coordinates for distance check
-    ScreenPos player_pos = player_get_screen_position(player, camera_y_offset);
-    const float EFFECT_RADIUS = 200.0f;  // how far the effect spreads from player
-    const float TRANSITION_RADIUS = 100.0f; // smooth transition zone
-    const float COLOR_RADIUS = 250.0f; 
-    
-    renderer->num_wave_points = 0;
-    for (int i = 0; i < WINDOW_WIDTH; i++) {
-        if (wave->points[i].activated) {
-            ScreenPos base_pos = world_to_screen(wave->points[i].x, wave->points[i].y, camera_y_offset);
-            
-            // Calculate distance from this point to player
-            float dx = base_pos.x - player_pos.x;
-            float dy = base_pos.y - player_pos.y;
-            float dist = sqrtf(dx * dx + dy * dy);
-            
-            // Smoothly fade the amplitude based on distance
-            float amplitude_factor = 1.0f;
-            if (dist > EFFECT_RADIUS - TRANSITION_RADIUS) {
-                amplitude_factor = fmaxf(0.0f, 
-                    1.0f - (dist - (EFFECT_RADIUS - TRANSITION_RADIUS)) / TRANSITION_RADIUS);
-            }
-            
-            float phase = i * frequency + time * wave_speed;
-            float x_offset = max_amplitude * amplitude_factor * sin(phase);
-            float y_offset = max_amplitude * amplitude_factor * cos(phase);
-            
-            renderer->wave_points[renderer->num_wave_points].x = base_pos.x + (int)x_offset;
-            renderer->wave_points[renderer->num_wave_points].y = base_pos.y + (int)y_offset;
-            renderer->num_wave_points++;
-        }
-    }
-
-    for (int i = 0; i < WINDOW_WIDTH - 1; i++) {
-        if (wave->points[i].activated) {
-            float mid_x = (renderer->wave_points[i].x + renderer->wave_points[i + 1].x) / 2.0f;
-            float mid_y = (renderer->wave_points[i].y + renderer->wave_points[i + 1].y) / 2.0f;
-            
-            float dx = mid_x - player_pos.x;
-            float dy = mid_y - player_pos.y;
-            float dist = sqrtf(dx * dx + dy * dy);
-            
-            float amplitude_factor = 1.0f;
-            if (dist > EFFECT_RADIUS - TRANSITION_RADIUS) {
-                amplitude_factor = fmaxf(0.0f, 
-                    1.0f - (dist - (EFFECT_RADIUS - TRANSITION_RADIUS)) / TRANSITION_RADIUS);
-            }
-            
-            // Calculate color based on x-distance
-            float x_distance = fabsf(mid_x - player_pos.x);
-            float color_factor = fmaxf(0.0f, 1.0f - x_distance / COLOR_RADIUS);
-            
-            // Combine phase and color factors
-            float gradient_t = color_factor * amplitude_factor;
-            
-            // Cyberpunk color scheme (cyan to magenta)
-            uint8_t r = amplitude_factor > 0.001f ? lerp(0, 255, amplitude_factor) : 10;    // cyan to magenta
-            uint8_t g = amplitude_factor > 0.001f ? lerp(255, 0, amplitude_factor) : x_distance < COLOR_RADIUS * 2 ? 255 : 10;
-            // uint8_t b = amplitude_factor > 0.001f ? lerp(255, 0, amplitude_factor) : x_distance < COLOR_RADIUS * 2 ? 255 : 0;
-            uint8_t b = x_distance < COLOR_RADIUS * 2 ? 255 : 10;
-            
-            SDL_SetRenderDrawColor(renderer->renderer, r, g, b, 255);
-            SDL_RenderDrawLine(renderer->renderer,
-                renderer->wave_points[i].x, 
-                renderer->wave_points[i].y,
-                renderer->wave_points[i + 1].x, 
-                renderer->wave_points[i + 1].y);
-        }
-    }
+#define WAVE_GRAIN 128  // columns per job
+
+static const float COLOR_RADIUS = 250.0f; 
+
+typedef struct {
+    Renderer* renderer;
+    const WavePoint* wave;       // visible window, WINDOW_WIDTH columns
+    ScreenPos player_pos;
+    F22 camera_y_offset;
+    float time;
+    bool skip_inactive;   // end-of-game wave only colors activated columns
+} WaveJob;
+
+static void wave_vertex_range(void* arg, int begin, int end) {
+    WaveJob* job = (WaveJob*)arg;
+    wave_build_vertices(job->wave, begin, end, job->camera_y_offset, job->player_pos,
+                        job->time, job->renderer->wave_slots);
 }
 
-void renderer_draw_wave(Renderer* renderer, const WaveGenerator* wave, const Player* player, F22 camera_y_offset) {
-    // SDL_SetRenderDrawColor(renderer->renderer, 255, 255, 255, 255);
-    float time = SDL_GetTicks() / 1000.0f;
-    float wave_speed = 2.0f;
-    float max_amplitude = 25.0f;
-    float frequency = 0.06f;
-    
-    // Get player position in screen coordinates for distance check
-    ScreenPos player_pos = player_get_screen_position(player, camera_y_offset);
-    const float EFFECT_RADIUS = 200.0f;  // how far the effect spreads from player
-    const float TRANSITION_RADIUS = 100.0f; // smooth transition zone
-    const float COLOR_RADIUS = 250.0f; 
+static void wave_color_range(void* arg, int begin, int end) {
+    WaveJob* job = (WaveJob*)arg;
+    const SDL_Point* points = job->renderer->wave_points;
+    ScreenPos player_pos = job->player_pos;
 
-    renderer->num_wave_points = 0;
-    for (int i = 0; i < WINDOW_WIDTH; i++) {
-        if (wave->points[i].activated) {
-            ScreenPos base_pos = world_to_screen(wave->points[i].x, wave->points[i].y, camera_y_offset);
-            
-            // Calculate distance from this point to player
-            float dx = base_pos.x - player_pos.x;
-            float dy = base_pos.y - player_pos.y;
-            float dist = sqrtf(dx * dx + dy * dy);
-            
-            // Smoothly fade the amplitude based on distance
-            float amplitude_factor = 1.0f;
-            if (dist > EFFECT_RADIUS - TRANSITION_RADIUS) {
-                amplitude_factor = fmaxf(0.0f, 
-                    1.0f - (dist - (EFFECT_RADIUS - TRANSITION_RADIUS)) / TRANSITION_RADIUS);
-            }
-            
-            float phase = i * frequency + time * wave_speed;
-            float x_offset = max_amplitude * amplitude_factor * sin(phase);
-            float y_offset = max_amplitude * amplitude_factor * cos(phase);
-            
-            renderer->wave_points[renderer->num_wave_points].x = base_pos.x + (int)x_offset;
-            renderer->wave_points[renderer->num_wave_points].y = base_pos.y + (int)y_offset;
-            renderer->num_wave_points++;
-        }
-    }
+    for (int i = begin; i < end; i++) {
+        // Following the player, part of the wave can be above or below the window
+        bool visible = cull_box_visible(min(points[i].x, points[i + 1].x), min(points[i].y, points[i + 1].y),
+                                        max(points[i].x, points[i + 1].x), max(points[i].y, points[i + 1].y));
+        job->renderer->wave_visible[i] = visible;
+        if (!visible) continue;
+        if (job->skip_inactive && !job->wave[i].activated) continue;
 
-    // Second pass: draw each segment with its own color
-    for (int i = 0; i < renderer->num_wave_points - 2; i++) {
         // Calculate color for this segment (use midpoint between points)
-        float mid_x = (renderer->wave_points[i].x + renderer->wave_points[i + 1].x) / 2.0f;
-        float mid_y = (renderer->wave_points[i].y + renderer->wave_points[i + 1].y) / 2.0f;
+        float mid_x = (points[i].x + points[i + 1].x) / 2.0f;
+        float mid_y = (points[i].y + points[i + 1].y) / 2.0f;
         
         float dx = mid_x - player_pos.x;
         float dy = mid_y - player_pos.y;
         float dist = sqrtf(dx * dx + dy * dy);
         
         float amplitude_factor = 1.0f;
-        if (dist > EFFECT_RADIUS - TRANSITION_RADIUS) {
+        if (dist > WAVE_EFFECT_RADIUS - WAVE_TRANSITION_RADIUS) {
             amplitude_factor = fmaxf(0.0f, 
-                1.0f - (dist - (EFFECT_RADIUS - TRANSITION_RADIUS)) / TRANSITION_RADIUS);
+                1.0f - (dist - (WAVE_EFFECT_RADIUS - WAVE_TRANSITION_RADIUS)) / WAVE_TRANSITION_RADIUS);
         }
         
         // Calculate color based on x-distance
         float x_distance = fabsf(mid_x - player_pos.x);
-        float color_factor = fmaxf(0.0f, 1.0f - x_distance / COLOR_RADIUS);
-        
-        // Combine phase and color factors
-        float gradient_t = color_factor * amplitude_factor;
         
         // Cyberpunk color scheme (cyan to magenta)
         uint8_t r = amplitude_factor > 0.001f ? lerp(0, 255, amplitude_factor) : 10;    // cyan to magenta
@@ -528,12 +544,86 @@ void renderer_draw_wave(Renderer* renderer, const WaveGenerator* wave, const Pla
         // uint8_t b = amplitude_factor > 0.001f ? lerp(255, 0, amplitude_factor) : x_distance < COLOR_RADIUS * 2 ? 255 : 0;
         uint8_t b = x_distance < COLOR_RADIUS * 2 ? 255 : 10;
         
-        SDL_SetRenderDrawColor(renderer->renderer, r, g, b, 255);
-        SDL_RenderDrawLine(renderer->renderer,
+        job->renderer->wave_colors[i] = (SDL_Color){ r, g, b, 255 };
+    }
+}
+
+// Builds the wave vertices and segment colors on the workers; returns the
+// number of segments whose color was computed
+static int renderer_prepare_wave(Renderer* renderer, WaveJob* job, bool end_of_game) {
+    jobs_parallel_for(renderer->jobs, WINDOW_WIDTH, WAVE_GRAIN, wave_vertex_range, job);
+
+    // Compaction has to be in column order, but it is just a copy
+    renderer->num_wave_points = 0;
+    for (int i = 0; i < WINDOW_WIDTH; i++) {
+        if (job->wave[i].activated) {
+            renderer->wave_points[renderer->num_wave_points++] = renderer->wave_slots[i];
+        }
+    }
+
+    int num_segments = end_of_game ? WINDOW_WIDTH - 1 : renderer->num_wave_points - 2;
+    if (num_segments > 0) {
+        jobs_parallel_for(renderer->jobs, num_segments, WAVE_GRAIN, wave_color_range, job);
+    }
+    return num_segments;
+}
+
+void renderer_end_wave(Renderer* renderer, const WavePoint* wave, const Player* player, F22 camera_y_offset) {
+    WaveJob job = {
+        .renderer = renderer,
+        .wave = wave,
+        // Get player position in screen coordinates for distance check
+        .player_pos = player_get_screen_position(player, camera_y_offset),
+        .camera_y_offset = camera_y_offset,
+        .time = renderer_ticks(renderer) / 1000.0f,
+        .skip_inactive = true
+    };
+    int num_segments = renderer_prepare_wave(renderer, &job, true);
+
+    for (int i = 0; i < num_segments; i++) {
+        if (wave[i].activated) {
+            cull_count(&renderer->cull.wave_segments, renderer->wave_visible[i]);
+            if (!renderer->wave_visible[i]) continue;
+            SDL_Color c = renderer->wave_colors[i];
+            canvas_color(&renderer->canvas, c.r, c.g, c.b, c.a);
+            canvas_line(&renderer->canvas,
+                renderer->wave_points[i].x, 
+                renderer->wave_points[i].y,
+                renderer->wave_points[i + 1].x, 
+                renderer->wave_points[i + 1].y);
+        }
+    }
+}
+
+void renderer_draw_wave(Renderer* renderer, const WavePoint* wave, const Player* player, F22 camera_y_offset) {
+    // SDL_SetRenderDrawColor(renderer->renderer, 255, 255, 255, 255);
+    WaveJob job = {
+        .renderer = renderer,
+        .wave = wave,
+        // Get player position in screen coordinates for distance check
+        .player_pos = player_get_screen_position(player, camera_y_offset),
+        .camera_y_offset = camera_y_offset,
+        .time = renderer_ticks(renderer) / 1000.0f,
+        .skip_inactive = false
+    };
+    int num_segments = renderer_prepare_wave(renderer, &job, false);
+    int step = renderer->quality.settings.wave_step;
+    if (step < 1) step = 1;
+
+    // Second pass: draw each segment with its own color; at lower quality
+    // one line spans step segments and takes the color of the first
+    for (int i = 0; i < num_segments; i += step) {
+        int next = i + step < num_segments ? i + step : num_segments;
+        bool visible = renderer->wave_visible[i] || renderer->wave_visible[next - 1];
+        cull_count(&renderer->cull.wave_segments, visible);
+        if (!visible) continue;
+        SDL_Color c = renderer->wave_colors[i];
+        canvas_color(&renderer->canvas, c.r, c.g, c.b, c.a);
+        canvas_line(&renderer->canvas,
             renderer->wave_points[i].x, 
             renderer->wave_points[i].y,
-            renderer->wave_points[i + 1].x, 
-            renderer->wave_points[i + 1].y);
+            renderer->wave_points[next].x, 
+            renderer->wave_points[next].y);
     }
 
     // if (renderer->num_wave_points > 1) {
@@ -550,8 +640,8 @@ void renderer_draw_wave(Renderer* renderer, const WaveGenerator* wave, const Pla
 //     // Just copy the wave points directly to renderer points, shifting x coordinates left
 //     renderer->num_wave_points = 0;
 //     for (int i = 0; i < WINDOW_WIDTH; i++) {
-//         if (wave->points[i].activated) {
-//             ScreenPos pos = world_to_screen(wave->points[i].x, wave->points[i].y, camera_y_offset);
+//         if (wave[i].activated) {
+//             ScreenPos pos = world_to_screen(wave[i].x, wave[i].y, camera_y_offset);
 //             renderer->wave_points[renderer->num_wave_points].x = pos.x;
 //             renderer->wave_points[renderer->num_wave_points].y = pos.y;
 //             renderer->num_wave_points++;
@@ -582,7 +672,7 @@ void renderer_rotate_points(SDL_Point* points, int num_points, SDL_Point center,
     }
 }
 
-void renderer_draw_thrust(SDL_Renderer* sdl_renderer, const SDL_Point center, float rotation, float time, const SDL_Point* thrust_shape) {
+void renderer_draw_thrust(const Canvas* canvas, Rng* rng, const SDL_Point center, float rotation, float time, const SDL_Point* thrust_shape) {
     SDL_Point animated_thrust[27];  // same size as original thrust array
     
     // Copy the base thrust points
@@ -600,7 +690,7 @@ void renderer_draw_thrust(SDL_Renderer* sdl_renderer, const SDL_Point center, fl
         
         // Randomly adjust length
         if(i % 2 == 1) {  // only adjust every other point for "stretchy" effect
-            animated_thrust[i].x -= (rand() % 5) - 2;
+            animated_thrust[i].x -= rng_range(rng, 5) - 2;
         }
     }
     
@@ -609,7 +699,7 @@ void renderer_draw_thrust(SDL_Renderer* sdl_renderer, const SDL_Point center, fl
         float phase = time * wave_speed * 1.2f + i * 0.3f;
         animated_thrust[i].y += (int)(wave_size * 1.5f * sinf(phase));
         if(i % 2 == 1) {
-            animated_thrust[i].x -= (rand() % 8) - 3;
+            animated_thrust[i].x -= rng_range(rng, 8) - 3;
         }
     }
     
@@ -618,7 +708,7 @@ void renderer_draw_thrust(SDL_Renderer* sdl_renderer, const SDL_Point center, fl
         float phase = time * wave_speed * 0.8f + i * 0.2f;
         animated_thrust[i].y += (int)(wave_size * 2.0f * sinf(phase));
         if(i % 2 == 1) {
-            animated_thrust[i].x -= (rand() % 10) - 4;
+            animated_thrust[i].x -= rng_range(rng, 10) - 4;
         }
     }
     
@@ -626,21 +716,21 @@ void renderer_draw_thrust(SDL_Renderer* sdl_renderer, const SDL_Point center, fl
     renderer_rotate_points(animated_thrust, 27, center, rotation);
 
     // Draw the animated flames with the original color scheme
-    SDL_SetRenderDrawColor(sdl_renderer, 255, 100, 0, 255);
-    SDL_RenderDrawLines(sdl_renderer, animated_thrust, 7);
+    canvas_color(canvas, 255, 100, 0, 255);
+    canvas_lines(canvas, animated_thrust, 7);
 
-    SDL_SetRenderDrawColor(sdl_renderer, 255, 150, 50, 255);
-    SDL_RenderDrawLines(sdl_renderer, animated_thrust + 7, 5);
+    canvas_color(canvas, 255, 150, 50, 255);
+    canvas_lines(canvas, animated_thrust + 7, 5);
 
-    SDL_SetRenderDrawColor(sdl_renderer, 255, 200, 0, 255);
-    SDL_RenderDrawLines(sdl_renderer, animated_thrust + 12, 15);
+    canvas_color(canvas, 255, 200, 0, 255);
+    canvas_lines(canvas, animated_thrust + 12, 15);
 
     // Add some random spark particles
-    SDL_SetRenderDrawColor(sdl_renderer, 255, 255, 200, 255);
+    canvas_color(canvas, 255, 255, 200, 255);
     for(int i = 0; i < 5; i++) {
         // Generate spark position near the engine
-        float spark_angle = ((float)rand() / (float)RAND_MAX) * M_PI - M_PI/2;  // -90 to 90 degrees
-        float distance = 60 + (rand() % 40);  // 60-100 pixels from center
+        float spark_angle = rng_float(rng) * M_PI - M_PI/2;  // -90 to 90 degrees
+        float distance = 60 + rng_range(rng, 40);  // 60-100 pixels from center
         
         float cos_rot = cosf((rotation + 180) * M_PI / 180.0f);  // +180 to point backwards
         float sin_rot = sinf((rotation + 180) * M_PI / 180.0f);
@@ -649,8 +739,8 @@ void renderer_draw_thrust(SDL_Renderer* sdl_renderer, const SDL_Point center, fl
         int spark_y = center.y + (int)(distance * sin_rot);
         
         // Draw a small cross for each spark
-        SDL_RenderDrawLine(sdl_renderer, spark_x-1, spark_y-1, spark_x+1, spark_y+1);
-        SDL_RenderDrawLine(sdl_renderer, spark_x-1, spark_y+1, spark_x+1, spark_y-1);
+        canvas_line(canvas, spark_x-1, spark_y-1, spark_x+1, spark_y+1);
+        canvas_line(canvas, spark_x-1, spark_y+1, spark_x+1, spark_y-1);
     }
 }
 
@@ -679,40 +769,42 @@ void renderer_draw_player(Renderer* renderer, const Player* player, F22 camera_y
     renderer_rotate_points(rotated_cock_pit, 5, center, player->rotation);
     renderer_rotate_points(rotated_pilot, 16, center, player->rotation);
 
+    const Canvas* canvas = &renderer->canvas;
+
     // Now fill with the rotated points
-    SDL_SetRenderDrawColor(renderer->renderer, 225, 225, 225, 255);
-    fill_polygon(renderer->renderer, rotated_f22, 32);
-    fill_polygon(renderer->renderer, rotated_left_wing, 4);
-    fill_polygon(renderer->renderer, rotated_left_tail, 6);
-    fill_polygon(renderer->renderer, rotated_cock_pit, 5);
+    canvas_color(canvas, 225, 225, 225, 255);
+    fill_polygon(canvas, rotated_f22, 32);
+    fill_polygon(canvas, rotated_left_wing, 4);
+    fill_polygon(canvas, rotated_left_tail, 6);
+    fill_polygon(canvas, rotated_cock_pit, 5);
 
     // Finally draw outlines
-    SDL_SetRenderDrawColor(renderer->renderer, 50, 50, 50, 255);
-    SDL_RenderDrawLines(renderer->renderer, rotated_f22, 32);
-    SDL_RenderDrawLines(renderer->renderer, rotated_left_wing, 4);
-    SDL_RenderDrawLines(renderer->renderer, rotated_left_tail, 6);
-    SDL_RenderDrawLines(renderer->renderer, rotated_cock_pit, 5);
+    canvas_color(canvas, 50, 50, 50, 255);
+    canvas_lines(canvas, rotated_f22, 32);
+    canvas_lines(canvas, rotated_left_wing, 4);
+    canvas_lines(canvas, rotated_left_tail, 6);
+    canvas_lines(canvas, rotated_cock_pit, 5);
 
 
 
 
     
     // Draw pilot with a different color (maybe dark gray to show silhouette)
-    SDL_SetRenderDrawColor(renderer->renderer, 50, 50, 50, 255);
+    canvas_color(canvas, 50, 50, 50, 255);
     // SDL_SetRenderDrawColor(renderer->renderer, 250, 250, 250, 255);
     for(int i = 0; i < 15; i++) {
-        SDL_RenderDrawLine(renderer->renderer, 
+        canvas_line(canvas, 
             rotated_pilot[i].x, rotated_pilot[i].y,
             rotated_pilot[i + 1].x, rotated_pilot[i + 1].y);
     }
     // Connect last point to first to close the circle
-    SDL_RenderDrawLine(renderer->renderer,
+    canvas_line(canvas,
         rotated_pilot[15].x, rotated_pilot[15].y,
         rotated_pilot[0].x, rotated_pilot[0].y);
 
     if (thrust_active) {
-        float time = SDL_GetTicks() / 1000.0f;  // get current time for animation
-        renderer_draw_thrust(renderer->renderer, center, player->rotation, time, renderer->thrust_shape);
+        float time = renderer_ticks(renderer) / 1000.0f;  // get current time for animation
+        renderer_draw_thrust(canvas, &renderer->rng, center, player->rotation, time, renderer->thrust_shape);
         // SDL_Point rotated_thrust[27];
         // memcpy(rotated_thrust, renderer->thrust_shape, sizeof(renderer->thrust_shape));
         // renderer_rotate_points(rotated_thrust, 27, center, player->rotation);
@@ -730,7 +822,7 @@ void renderer_draw_player(Renderer* renderer, const Player* player, F22 camera_y
 }
 
 void renderer_draw_obstacles(Renderer* renderer, const Obstacle* obstacles) {
-    SDL_SetRenderDrawColor(renderer->renderer, 150, 150, 150, 255);
+    canvas_color(&renderer->canvas, 150, 150, 150, 255);
 
     for (int i = 0; i < MAX_OBSTACLES; i++) {
         if (!obstacles[i].active) continue;
@@ -744,7 +836,7 @@ void renderer_draw_obstacles(Renderer* renderer, const Obstacle* obstacles) {
             .w = OBSTACLE_WIDTH,
             .h = pos.y - 100
         };
-        SDL_RenderFillRect(renderer->renderer, &top_rect);
+        canvas_fill_rect(&renderer->canvas, &top_rect);
 
         // Draw bottom obstacle
         SDL_Rect bottom_rect = {
@@ -753,17 +845,32 @@ void renderer_draw_obstacles(Renderer* renderer, const Obstacle* obstacles) {
             .w = OBSTACLE_WIDTH,
             .h = WINDOW_HEIGHT - (pos.y + 100)
         };
-        SDL_RenderFillRect(renderer->renderer, &bottom_rect);
+        canvas_fill_rect(&renderer->canvas, &bottom_rect);
     }
 }
 
-void renderer_draw_frame(Renderer* renderer, const GameState* state, bool thrust_active) {
+void renderer_draw_frame(Renderer* renderer, const RenderFrame* frame) {
+    const Canvas* canvas = &renderer->canvas;
+    renderer->cull = (CullStats){0};
+    const QualitySettings* quality = &renderer->quality.settings;
+    renderer->background->star_count = quality->star_count;
+    if (renderer->profile) renderer->profile->mark = SDL_GetPerformanceCounter();
+    quality_begin(&renderer->quality);
+    if (canvas->raster) {
+        // The rasterizer applies the scale itself
+        dynres_begin(&renderer->dynres, NULL);
+        raster_begin(canvas->raster, renderer->dynres.scale);
+    } else {
+        dynres_begin(&renderer->dynres, renderer->renderer);
+    }
+
     // Clear screen
-    SDL_SetRenderDrawColor(renderer->renderer, 10, 10, 10, 255);
-    SDL_RenderClear(renderer->renderer);
-    draw_background(renderer->renderer, renderer->background, state);
+    canvas_color(canvas, 10, 10, 10, 255);
+    canvas_clear(canvas);
+    draw_background(canvas, renderer->background, renderer->jobs, frame);
+    renderer_profile_mark(renderer, RENDER_STAGE_BACKGROUND);
 
-    if (state->state == GAME_STATE_WAITING) {
+    if (frame->state == GAME_STATE_WAITING) {
         // Draw simple waiting state
         // SDL_SetRenderDrawColor(renderer->renderer, 255, 255, 255, 255);
         // SDL_Rect prompt = {
@@ -773,30 +880,52 @@ void renderer_draw_frame(Renderer* renderer, const GameState* state, bool thrust
         //     .h = 40
         // };
         // SDL_RenderFillRect(renderer->renderer, &prompt);
-        asteroid_system_render(&state->asteroid_system, renderer->renderer, state->camera_y_offset, &state->player);
+        asteroid_system_render(&frame->asteroid_system, canvas, renderer->jobs, frame->camera_y_offset, &frame->player, quality->trail_step, &renderer->cull);
+        renderer_profile_mark(renderer, RENDER_STAGE_ASTEROIDS);
     } else {
         // Normal game rendering
-        // renderer_draw_obstacles(renderer, state->obstacles);
-        if (state->state == GAME_STATE_PLAYING) {
-            renderer_draw_wave(renderer, &state->wave, &state->player, state->camera_y_offset);
+        // renderer_draw_obstacles(renderer, frame->obstacles);
+        if (frame->state == GAME_STATE_PLAYING) {
+            renderer_draw_wave(renderer, frame->wave, &frame->player, frame->camera_y_offset);
         } else {
-            renderer_end_wave(renderer, &state->wave, &state->player, state->camera_y_offset);
+            renderer_end_wave(renderer, frame->wave, &frame->player, frame->camera_y_offset);
         }
+        renderer_profile_mark(renderer, RENDER_STAGE_WAVE);
         
-        asteroid_system_render(&state->asteroid_system, renderer->renderer, state->camera_y_offset, &state->player);
-        // missile_system_render(&state->missile_system, renderer->renderer, state->camera_y_offset);
+        asteroid_system_render(&frame->asteroid_system, canvas, renderer->jobs, frame->camera_y_offset, &frame->player, quality->trail_step, &renderer->cull);
+        renderer_profile_mark(renderer, RENDER_STAGE_ASTEROIDS);
+        // missile_system_render(&frame->missile_system, renderer->renderer, frame->camera_y_offset);
     }
 
     // Always draw player and score
-    // missile_system_render_ui(&state->missile_system, renderer->renderer);
-    float time = SDL_GetTicks() / 1000.0f;
-    renderer_draw_barrier(renderer->renderer, time, state->camera_y_offset);
-    if (!state->explosion.active) {
-        renderer_draw_player(renderer, &state->player, state->camera_y_offset, state->state == GAME_STATE_PLAYING ? thrust_active : true);
+    // missile_system_render_ui(&frame->missile_system, renderer->renderer);
+    float time = renderer_ticks(renderer) / 1000.0f;
+    renderer_draw_barrier(canvas, renderer->jobs, time, frame->camera_y_offset, quality->barrier_points);
+    renderer_profile_mark(renderer, RENDER_STAGE_BARRIER);
+    if (!frame->explosion.active) {
+        renderer_draw_player(renderer, &frame->player, frame->camera_y_offset, frame->state == GAME_STATE_PLAYING ? frame->thrust_active : true);
+    }
+    renderer_profile_mark(renderer, RENDER_STAGE_PLAYER);
+    explosion_render(&frame->explosion, canvas, frame->camera_y_offset, quality->spark_limit, &renderer->cull);
+    renderer_profile_mark(renderer, RENDER_STAGE_EXPLOSION);
+    if (canvas->raster) {
+        raster_render(canvas->raster);
+        renderer_profile_mark(renderer, RENDER_STAGE_RASTER);
+        raster_present(canvas->raster, renderer->renderer);
+    } else {
+        dynres_end(&renderer->dynres, renderer->renderer);
     }
-    explosion_render(&state->explosion, renderer->renderer, state->camera_y_offset);
-    // renderer_draw_score(renderer, state->score);
+    renderer_profile_mark(renderer, RENDER_STAGE_UPSCALE);
+    hud_draw(&renderer->hud, renderer->renderer, frame);
+    renderer_profile_mark(renderer, RENDER_STAGE_HUD);
+    quality_end(&renderer->quality);
+    dynres_submit_done(&renderer->dynres);
+    if (renderer->capture) capture_frame(renderer->capture, renderer->renderer);
+    renderer_profile_mark(renderer, RENDER_STAGE_CAPTURE);
 
     SDL_RenderPresent(renderer->renderer);
+    dynres_frame_done(&renderer->dynres);
+    renderer_profile_mark(renderer, RENDER_STAGE_PRESENT);
+    if (renderer->profile) renderer->profile->frames++;
 
 }
@@ -2,8 +2,16 @@
 #define RENDERER_H
 
 #include <SDL.h>
-// #include <SDL_ttf.h>
 #include "game_state.h"
+#include "frame.h"
+#include "rng.h"
+#include "jobs.h"
+#include "hud.h"
+#include "cull.h"
+#include "dynres.h"
+#include "quality.h"
+#include "canvas.h"
+#include "capture.h"
 
 typedef struct {
     float x, y;      // Star position
@@ -11,14 +19,20 @@ typedef struct {
     float speed;     // Movement speed
     float hue;       // Color variation
     int brightness;
+    SDL_Color color;   // picked when the star layer is refreshed
 } Star;
 
+#define BACKGROUND_STARS 50
+
 typedef struct {
     Star stars[250];
+    int star_count;             // drawn, of BACKGROUND_STARS; all of them move
     float gradient_opacity;
     int gradient_direction;
     uint32_t last_frame;
     SDL_Texture* star_texture;  // Add texture to store star layer
+    bool star_texture_ready;    // drawn on the first frame, not during init
+    Rng rng;                    // star placement/twinkle only
 } Background;
 
 typedef struct {
@@ -27,9 +41,33 @@ typedef struct {
     float lifetime;
 } WaveParticle;
 
+typedef enum {
+    RENDER_STAGE_BACKGROUND,
+    RENDER_STAGE_WAVE,
+    RENDER_STAGE_ASTEROIDS,
+    RENDER_STAGE_BARRIER,
+    RENDER_STAGE_PLAYER,
+    RENDER_STAGE_EXPLOSION,
+    RENDER_STAGE_RASTER,       // CPU rasterizer, when enabled
+    RENDER_STAGE_UPSCALE,      // dynamic resolution or raster texture copy
+    RENDER_STAGE_HUD,
+    RENDER_STAGE_CAPTURE,      // readback for capture_frame, when recording
+    RENDER_STAGE_PRESENT,
+    RENDER_STAGE_COUNT
+} RenderStage;
+
+// Time spent in each part of renderer_draw_frame, summed over frames
 typedef struct {
-    SDL_Window* window;
+    double ms[RENDER_STAGE_COUNT];
+    int frames;
+    uint64_t mark;             // end of the previous stage
+} RenderProfile;
+
+typedef struct {
+    SDL_Window* window;        // NULL for a headless renderer
     SDL_Renderer* renderer;
+    Canvas canvas;             // the scene's draw calls; HUD goes to renderer
+    Raster raster;             // set up by renderer_use_raster
     Background* background;
     SDL_Point f22_shape[32];     // Store F22 shape points
     SDL_Point thrust_shape[27];  // Store thrust effect points
@@ -38,22 +76,40 @@ typedef struct {
     SDL_Point cock_pit[5];
     SDL_Point pilot_circle[16];
     SDL_Point wave_points[WINDOW_WIDTH];
+    SDL_Point wave_slots[WINDOW_WIDTH];    // per-column vertex before compaction
+    SDL_Color wave_colors[WINDOW_WIDTH];   // per-segment color
+    bool wave_visible[WINDOW_WIDTH];       // per-segment; culled ones get no color
     WaveParticle particles[1000];
     int num_particles;
     uint32_t last_particle_spawn;
     int num_wave_points;
+    Rng rng;                     // visual-only randomness (thrust flicker)
+    JobSystem* jobs;             // vertex generation workers; NULL runs inline
+    Hud hud;                     // drawn at native resolution
+    DynamicResolution dynres;    // scene resolution
+    QualityGovernor quality;     // effect detail
+    CullStats cull;              // counts for the last frame drawn
+    RenderProfile* profile;      // filled by renderer_draw_frame when set
+    Capture* capture;            // gets every frame before present when set
+    bool clock_fixed;            // animate from clock_ticks instead of SDL_GetTicks
+    uint32_t clock_ticks;
 } Renderer;
 
-Background* background_init(SDL_Renderer* renderer);
+Background* background_init(SDL_Renderer* renderer, uint64_t seed);
 void update_star_texture(SDL_Renderer* renderer, Background* bg);
-void draw_background(SDL_Renderer* renderer, Background* bg, const GameState* const);
+void draw_background(const Canvas* canvas, Background* bg, JobSystem* jobs, const RenderFrame* frame);
 void DrawCircle(SDL_Renderer* renderer, int cx, int cy, int radius);
 
 // Core rendering functions
-int renderer_init(Renderer* renderer);
+int renderer_init(Renderer* renderer, JobSystem* jobs, uint64_t seed);
+// Software renderer drawing into surface, with no window (src/render_bench.c)
+int renderer_init_headless(Renderer* renderer, JobSystem* jobs, uint64_t seed, SDL_Surface* surface);
 void renderer_cleanup(Renderer* renderer);
-void renderer_draw_frame(Renderer* renderer, const GameState* state, bool thrust_active);
-void renderer_draw_wave(Renderer* renderer, const WaveGenerator* wave, const Player* player, F22 camera_offset);
+// Draws the scene with the CPU rasterizer (src/raster.h) instead of SDL draw
+// calls; returns whether it is in use. On by default with F22_CPU_RASTER.
+bool renderer_use_raster(Renderer* renderer, bool enable);
+void renderer_draw_frame(Renderer* renderer, const RenderFrame* frame);
+void renderer_draw_wave(Renderer* renderer, const WavePoint* wave, const Player* player, F22 camera_offset);
 
 // Helper functions
 void renderer_init_shapes(Renderer* renderer);
@@ -61,8 +117,4 @@ void renderer_rotate_points(SDL_Point* points, int num_points, SDL_Point center,
 void renderer_draw_player(Renderer* renderer, const Player* player, F22 camera_y_offset, bool thrust_active);
 void renderer_draw_obstacles(Renderer* renderer, const Obstacle* obstacles);
 
-// void renderer_draw_text(Renderer* renderer, const char* text, int x, int y, SDL_Color color);
-// int renderer_init_font(Renderer* renderer, const char* font_path, int font_size);
-// void renderer_cleanup_font(Renderer* renderer);
-
 #endif // RENDERER_H
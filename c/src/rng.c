@@ -0,0 +1,12 @@
+#include "rng.h"
+
+Rng rng_init(uint64_t seed, uint64_t stream) {
+    Rng rng = {
+        .state = 0,
+        .inc = (stream << 1u) | 1u
+    };
+    rng_next(&rng);
+    rng.state += seed;
+    rng_next(&rng);
+    return rng;
+}
@@ -0,0 +1,47 @@
+#ifndef RNG_H
+#define RNG_H
+
+#include <stdint.h>
+
+// PCG32 generator (O'Neill, pcg-random.org). 16 bytes of state, no locks,
+// so every subsystem can own its own stream and parallel simulations never
+// share hidden state the way rand() does.
+typedef struct {
+    uint64_t state;
+    uint64_t inc;   // stream selector, always odd
+} Rng;
+
+// Stream ids. Gameplay streams (wave, asteroids) are kept separate from the
+// purely visual ones so that e.g. drawing thrust flames never changes the
+// asteroid field for a given seed.
+typedef enum {
+    RNG_STREAM_WAVE = 1,
+    RNG_STREAM_ASTEROIDS,
+    RNG_STREAM_EXPLOSION,
+    RNG_STREAM_SMOKE,
+    RNG_STREAM_RENDER,
+    RNG_STREAM_BACKGROUND,
+    RNG_STREAM_SOUND
+} RngStream;
+
+Rng rng_init(uint64_t seed, uint64_t stream);
+
+static inline uint32_t rng_next(Rng* rng) {
+    uint64_t old = rng->state;
+    rng->state = old * 6364136223846793005ULL + rng->inc;
+    uint32_t xorshifted = (uint32_t)(((old >> 18u) ^ old) >> 27u);
+    uint32_t rot = (uint32_t)(old >> 59u);
+    return (xorshifted >> rot) | (xorshifted << ((-rot) & 31));
+}
+
+// Uniform float in [0, 1)
+static inline float rng_float(Rng* rng) {
+    return (rng_next(rng) >> 8) * (1.0f / 16777216.0f);
+}
+
+// Uniform int in [0, n), n > 0
+static inline int rng_range(Rng* rng, int n) {
+    return (int)(((uint64_t)rng_next(rng) * (uint32_t)n) >> 32);
+}
+
+#endif // RNG_H
@@ -0,0 +1,201 @@
+#include "sim.h"
+#include <SDL.h>
+#include <stdio.h>
+#include <string.h>
+
+#define FRAME_FRESH 4        // set on the middle slot index when it is unread
+#define FRAME_SLOT_MASK 3
+
+struct SimThread {
+    GameState* state;
+
+    // Triple buffer: the simulation writes slots[back], the renderer reads
+    // slots[front], and the two swap with the middle slot atomically.
+    RenderFrame slots[3];
+    int back;                // simulation thread only
+    SDL_atomic_t middle;
+    int front;               // render thread only
+    RenderFrame prev;        // render thread only: the frame before front
+    bool have_front;
+    bool have_prev;
+
+    SDL_atomic_t thrust;
+    SDL_atomic_t clicks;
+    SDL_atomic_t running;
+    SDL_Thread* thread;
+
+    // Simulation thread only
+    bool thrust_applied;
+    bool finished;
+    uint32_t tick;
+    uint64_t next_tick;      // performance-counter time the next tick is due
+    uint64_t tick_length;
+};
+
+SimThread* sim_create(GameState* state) {
+    SimThread* sim = SDL_calloc(1, sizeof(SimThread));
+    if (!sim) return NULL;
+
+    sim->state = state;
+    sim->back = 0;
+    SDL_AtomicSet(&sim->middle, 1);
+    sim->front = 2;
+    sim->tick_length = SDL_GetPerformanceFrequency() / SIM_TICK_RATE;
+    sim->next_tick = SDL_GetPerformanceCounter();
+    return sim;
+}
+
+static void sim_publish(SimThread* sim, uint64_t timestamp) {
+    RenderFrame* frame = &sim->slots[sim->back];
+    frame_capture(frame, sim->state, sim->thrust_applied);
+    frame->tick = sim->tick;
+    frame->timestamp = timestamp;
+    // SDL_AtomicSet is only an acquire barrier on some compilers; the frame
+    // must be visible before its index is, and the slot handed back must be
+    // done being read before it is overwritten
+    SDL_MemoryBarrierRelease();
+    sim->back = SDL_AtomicSet(&sim->middle, sim->back | FRAME_FRESH) & FRAME_SLOT_MASK;
+    SDL_MemoryBarrierAcquire();
+}
+
+static void sim_apply_input(SimThread* sim) {
+    GameState* state = sim->state;
+    if (state->state == GAME_STATE_OVER) return;
+
+    if (SDL_AtomicSet(&sim->clicks, 0) > 0) {
+        game_state_handle_click(state, 0, 0);
+    }
+
+    bool thrust = SDL_AtomicGet(&sim->thrust) != 0;
+    if (thrust != sim->thrust_applied) {
+        if (thrust) {
+            sound_system_start_engine(&state->sound_system);
+        } else {
+            sound_system_stop_engine(&state->sound_system);
+        }
+        sim->thrust_applied = thrust;
+    }
+}
+
+static void sim_tick(SimThread* sim, uint64_t timestamp) {
+    const float FIXED_TIME_STEP = 1.0f / SIM_TICK_RATE;
+
+    sim_apply_input(sim);
+    game_state_update(sim->state, sim->thrust_applied, FIXED_TIME_STEP);
+
+    // Screen y grows downwards, so a negative velocity is a climb
+    float velocity = f22_to_float(sim->state->player.velocity.y);
+    sound_system_set_engine_climb(&sim->state->sound_system, -velocity / f22_to_float(MAX_VELOCITY));
+
+    // Check collisions - the explosion keeps playing until it finishes
+    if (game_state_check_collisions(sim->state) &&
+        sim->state->explosion.time >= EXPLOSION_DURATION) {
+        sim->finished = true;
+    }
+
+    sim->tick++;
+    sim_publish(sim, timestamp);
+}
+
+static void sim_run_due(SimThread* sim) {
+    uint64_t now = SDL_GetPerformanceCounter();
+
+    // Far behind (debugger, suspended tab): drop the backlog instead of
+    // fast-forwarding through it
+    if (now > sim->next_tick + SDL_GetPerformanceFrequency() / 4) {
+        sim->next_tick = now;
+    }
+
+    while (!sim->finished && now >= sim->next_tick) {
+        sim_tick(sim, sim->next_tick);
+        sim->next_tick += sim->tick_length;
+    }
+}
+
+void sim_advance(SimThread* sim) {
+    sim_run_due(sim);
+}
+
+static int sim_thread_main(void* arg) {
+    SimThread* sim = (SimThread*)arg;
+    uint64_t frequency = SDL_GetPerformanceFrequency();
+
+    while (SDL_AtomicGet(&sim->running) && !sim->finished) {
+        sim_run_due(sim);
+
+        uint64_t now = SDL_GetPerformanceCounter();
+        if (now < sim->next_tick) {
+            uint32_t wait_ms = (uint32_t)((sim->next_tick - now) * 1000 / frequency);
+            if (wait_ms > 0) SDL_Delay(wait_ms);
+        }
+    }
+    return 0;
+}
+
+bool sim_start(SimThread* sim) {
+    #if defined(__EMSCRIPTEN__) && !defined(__EMSCRIPTEN_PTHREADS__)
+    return false;
+    #else
+    sim->next_tick = SDL_GetPerformanceCounter();
+    SDL_AtomicSet(&sim->running, 1);
+    sim->thread = SDL_CreateThread(sim_thread_main, "f22_sim", sim);
+    if (!sim->thread) {
+        printf("Failed to start simulation thread: %s\n", SDL_GetError());
+        SDL_AtomicSet(&sim->running, 0);
+        return false;
+    }
+    return true;
+    #endif
+}
+
+void sim_destroy(SimThread* sim) {
+    if (!sim) return;
+    if (sim->thread) {
+        SDL_AtomicSet(&sim->running, 0);
+        SDL_WaitThread(sim->thread, NULL);
+    }
+    SDL_free(sim);
+}
+
+void sim_set_thrust(SimThread* sim, bool thrust_active) {
+    SDL_AtomicSet(&sim->thrust, thrust_active ? 1 : 0);
+}
+
+void sim_click(SimThread* sim) {
+    SDL_AtomicAdd(&sim->clicks, 1);
+}
+
+bool sim_render_frame(SimThread* sim, RenderFrame* out) {
+    if (SDL_AtomicGet(&sim->middle) & FRAME_FRESH) {
+        if (sim->have_front) {
+            memcpy(&sim->prev, &sim->slots[sim->front], sizeof(RenderFrame));
+            sim->have_prev = true;
+        }
+        // Pairs with the barriers in sim_publish
+        SDL_MemoryBarrierRelease();
+        sim->front = SDL_AtomicSet(&sim->middle, sim->front) & FRAME_SLOT_MASK;
+        SDL_MemoryBarrierAcquire();
+        sim->have_front = true;
+    }
+    if (!sim->have_front) return false;
+
+    const RenderFrame* curr = &sim->slots[sim->front];
+    if (!sim->have_prev || curr->tick != sim->prev.tick + 1) {
+        // Skipped ticks (slow renderer) or the first frame: nothing to blend
+        *out = *curr;
+        return true;
+    }
+
+    // Draw one tick behind the simulation: alpha runs 0..1 over the tick
+    // that started at curr->timestamp
+    uint64_t now = SDL_GetPerformanceCounter();
+    uint64_t span = curr->timestamp - sim->prev.timestamp;
+    float alpha = 1.0f;
+    if (span > 0 && now > curr->timestamp) {
+        alpha = (float)(now - curr->timestamp) / (float)span;
+    } else if (now <= curr->timestamp) {
+        alpha = 0.0f;
+    }
+    frame_interpolate(out, &sim->prev, curr, alpha > 1.0f ? 1.0f : alpha);
+    return true;
+}
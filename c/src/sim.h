@@ -0,0 +1,33 @@
+#ifndef SIM_H
+#define SIM_H
+
+#include <stdbool.h>
+#include "game_state.h"
+#include "frame.h"
+
+#define SIM_TICK_RATE 60
+
+// Runs game_state_update at a fixed rate, on its own thread when threads are
+// available. Every tick is published as a RenderFrame through a lock-free
+// triple buffer, so neither the simulation nor the renderer waits on the other.
+// Input reaches the simulation through atomics; after sim_start the GameState
+// belongs to the simulation thread.
+typedef struct SimThread SimThread;
+
+SimThread* sim_create(GameState* state);
+void sim_destroy(SimThread* sim);   // stops the thread first
+
+// Returns false when no thread could be started; the caller must then drive
+// the simulation itself with sim_advance
+bool sim_start(SimThread* sim);
+void sim_advance(SimThread* sim);   // runs every tick that is due, on this thread
+
+// Input, callable from the event thread
+void sim_set_thrust(SimThread* sim, bool thrust_active);
+void sim_click(SimThread* sim);
+
+// Fills out with the latest state blended between the two newest ticks.
+// Render thread only; returns false until the first tick is published.
+bool sim_render_frame(SimThread* sim, RenderFrame* out);
+
+#endif // SIM_H
@@ -4,28 +4,29 @@
 #include <stdio.h>
 #include <SDL.h>
 
-SmokeSystem smoke_system_init(void) {
+SmokeSystem smoke_system_init(uint64_t seed) {
     SmokeSystem system;
     memset(&system, 0, sizeof(SmokeSystem));
+    system.rng = rng_init(seed, RNG_STREAM_SMOKE);
     return system;
 }
 
-void create_particle(SmokeParticle* particle, float x, float y) {
-    particle->active = true;
-    particle->x = x;
-    particle->y = y;
+void create_particle(SmokeParticles* particles, int index, Rng* rng, float x, float y) {
+    particles->active[index] = true;
+    particles->x[index] = x;
+    particles->y[index] = y;
     
     // Random velocity in circle
-    float angle = ((float)rand() / (float)RAND_MAX) * 2 * M_PI;
-    float speed = 0.5f + ((float)rand() / (float)RAND_MAX) * 2.0f;
-    particle->vx = cosf(angle) * speed;
-    particle->vy = sinf(angle) * speed;
+    float angle = rng_float(rng) * 2 * M_PI;
+    float speed = 0.5f + rng_float(rng) * 2.0f;
+    particles->vx[index] = cosf(angle) * speed;
+    particles->vy[index] = sinf(angle) * speed;
     
     // Random size and lifetime
-    particle->size = 3.0f + ((float)rand() / (float)RAND_MAX) * 8.0f;
-    particle->max_lifetime = 1.0f + ((float)rand() / (float)RAND_MAX) * 2.0f;
-    particle->lifetime = 0;
-    particle->alpha = 255;
+    particles->size[index] = 3.0f + rng_float(rng) * 8.0f;
+    particles->max_lifetime[index] = 1.0f + rng_float(rng) * 2.0f;
+    particles->lifetime[index] = 0;
+    particles->alpha[index] = 255;
 }
 
 void smoke_system_start(SmokeSystem* system, const Player* player) {
@@ -41,11 +42,89 @@ void smoke_system_start(SmokeSystem* system, const Player* player) {
     
     // Create initial burst of particles
     for (int i = 0; i < MAX_PARTICLES; i++) {
-        create_particle(&system->particles[i], x, y);
+        create_particle(&system->particles, i, &system->rng, x, y);
     }
 }
 
-void smoke_system_update(SmokeSystem* system, float delta_time) {
+#define SMOKE_GRAIN 32
+
+typedef struct {
+    SmokeSystem* system;
+    float delta_time;
+} SmokeJob;
+
+static void update_particle(SmokeParticles* p, int i, float delta_time) {
+    p->lifetime[i] += delta_time;
+    if (p->lifetime[i] >= p->max_lifetime[i]) {
+        p->active[i] = false;
+        return;
+    }
+    
+    // Update position with slow down
+    p->x[i] += p->vx[i] * (1.0f - p->lifetime[i] / p->max_lifetime[i]);
+    p->y[i] += p->vy[i] * (1.0f - p->lifetime[i] / p->max_lifetime[i]);
+    
+    // Grow size over time
+    p->size[i] += delta_time * 5.0f;
+    
+    // Fade out
+    float life_ratio = p->lifetime[i] / p->max_lifetime[i];
+    p->alpha[i] = (uint8_t)(255.0f * (1.0f - life_ratio));
+}
+
+#ifdef __wasm_simd128__
+// Particles i..i+3 with the same arithmetic as update_particle. Inactive
+// lanes keep their values and expired ones only their new lifetime.
+static void update_particles_x4(SmokeParticles* p, int i, float delta_time) {
+    int active = p->active[i] | p->active[i + 1] << 1 | p->active[i + 2] << 2 | p->active[i + 3] << 3;
+    if (!active) return;
+    v128_t active_mask = wasm_i32x4_make(-p->active[i], -p->active[i + 1], -p->active[i + 2], -p->active[i + 3]);
+
+    v128_t max_lifetime = wasm_v128_load(&p->max_lifetime[i]);
+    v128_t old_lifetime = wasm_v128_load(&p->lifetime[i]);
+    v128_t lifetime = wasm_f32x4_add(old_lifetime, wasm_f32x4_splat(delta_time));
+    v128_t expired = wasm_f32x4_ge(lifetime, max_lifetime);
+    v128_t live = wasm_v128_andnot(active_mask, expired);
+    wasm_v128_store(&p->lifetime[i], wasm_v128_bitselect(lifetime, old_lifetime, active_mask));
+
+    v128_t fade = wasm_f32x4_sub(wasm_f32x4_splat(1.0f), wasm_f32x4_div(lifetime, max_lifetime));
+    v128_t x = wasm_v128_load(&p->x[i]);
+    v128_t y = wasm_v128_load(&p->y[i]);
+    v128_t size = wasm_v128_load(&p->size[i]);
+    wasm_v128_store(&p->x[i], wasm_v128_bitselect(
+        wasm_f32x4_add(x, wasm_f32x4_mul(wasm_v128_load(&p->vx[i]), fade)), x, live));
+    wasm_v128_store(&p->y[i], wasm_v128_bitselect(
+        wasm_f32x4_add(y, wasm_f32x4_mul(wasm_v128_load(&p->vy[i]), fade)), y, live));
+    wasm_v128_store(&p->size[i], wasm_v128_bitselect(
+        wasm_f32x4_add(size, wasm_f32x4_splat(delta_time * 5.0f)), size, live));
+
+    int32_t alpha[4];
+    wasm_v128_store(alpha, wasm_i32x4_trunc_sat_f32x4(wasm_f32x4_mul(wasm_f32x4_splat(255.0f), fade)));
+    int live_bits = wasm_i32x4_bitmask(live);
+    for (int k = 0; k < 4; k++) {
+        if (live_bits & (1 << k)) p->alpha[i + k] = (uint8_t)alpha[k];
+        else if (active & (1 << k)) p->active[i + k] = false;
+    }
+}
+#endif
+
+static void update_particle_range(void* arg, int begin, int end) {
+    SmokeJob* job = (SmokeJob*)arg;
+    SmokeParticles* particles = &job->system->particles;
+    int i = begin;
+
+    #ifdef __wasm_simd128__
+    for (; i + 4 <= end; i += 4) {
+        update_particles_x4(particles, i, job->delta_time);
+    }
+    #endif
+    for (; i < end; i++) {
+        if (!particles->active[i]) continue;
+        update_particle(particles, i, job->delta_time);
+    }
+}
+
+void smoke_system_update(SmokeSystem* system, JobSystem* jobs, float delta_time) {
     if (!system->active) return;
     
     system->time += delta_time;
@@ -54,27 +133,8 @@ void smoke_system_update(SmokeSystem* system, float delta_time) {
         return;
     }
     
-    for (int i = 0; i < MAX_PARTICLES; i++) {
-        SmokeParticle* p = &system->particles[i];
-        if (!p->active) continue;
-        
-        p->lifetime += delta_time;
-        if (p->lifetime >= p->max_lifetime) {
-            p->active = false;
-            continue;
-        }
-        
-        // Update position with slow down
-        p->x += p->vx * (1.0f - p->lifetime / p->max_lifetime);
-        p->y += p->vy * (1.0f - p->lifetime / p->max_lifetime);
-        
-        // Grow size over time
-        p->size += delta_time * 5.0f;
-        
-        // Fade out
-        float life_ratio = p->lifetime / p->max_lifetime;
-        p->alpha = (uint8_t)(255.0f * (1.0f - life_ratio));
-    }
+    SmokeJob job = { system, delta_time };
+    jobs_parallel_for(jobs, MAX_PARTICLES, SMOKE_GRAIN, update_particle_range, &job);
 }
 
 ScreenPos __world_to_screen(F22 world_x, F22 world_y, F22 camera_y_offset) {
@@ -89,20 +149,20 @@ void smoke_system_render(const SmokeSystem* system, SDL_Renderer* renderer, F22
     if (!system->active) return;
 
     for (int i = 0; i < MAX_PARTICLES; i++) {
-        const SmokeParticle* p = &system->particles[i];
-        if (!p->active) continue;
+        const SmokeParticles* p = &system->particles;
+        if (!p->active[i]) continue;
         
         ScreenPos pos = __world_to_screen(
-            f22_from_float(p->x),
-            f22_from_float(p->y),
+            f22_from_float(p->x[i]),
+            f22_from_float(p->y[i]),
             camera_y_offset
         );
         
         // Draw smoke particle as a circle or filled rectangle
-        SDL_SetRenderDrawColor(renderer, 200, 200, 200, p->alpha);
+        SDL_SetRenderDrawColor(renderer, 200, 200, 200, p->alpha[i]);
         
         // Simple filled circle approximation
-        int size = (int)p->size;
+        int size = (int)p->size[i];
         for (int y = -size; y <= size; y++) {
             for (int x = -size; x <= size; x++) {
                 if (x*x + y*y <= size*size) {
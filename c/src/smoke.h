@@ -4,30 +4,35 @@
 #include "f22.h"
 #include "player.h"
 #include <stdbool.h>
+#include "rng.h"
+#include "jobs.h"
 
 #define MAX_PARTICLES 128
 
+// Struct of arrays: particle i is element i of every array, so the update
+// can load four particles per SIMD step (src/smoke.c)
 typedef struct {
-    float x, y;
-    float vx, vy;
-    float size;
-    float lifetime;
-    float max_lifetime;
-    uint8_t alpha;
-    bool active;
-} SmokeParticle;
+    float x[MAX_PARTICLES], y[MAX_PARTICLES];
+    float vx[MAX_PARTICLES], vy[MAX_PARTICLES];
+    float size[MAX_PARTICLES];
+    float lifetime[MAX_PARTICLES];
+    float max_lifetime[MAX_PARTICLES];
+    uint8_t alpha[MAX_PARTICLES];
+    bool active[MAX_PARTICLES];
+} SmokeParticles;
 
 typedef struct {
-    SmokeParticle particles[MAX_PARTICLES];
+    SmokeParticles particles;
     bool active;
     float time;
     F22 origin_x;
     F22 origin_y;
+    Rng rng;
 } SmokeSystem;
 
-SmokeSystem smoke_system_init();
-void create_particle(SmokeParticle* particle, float x, float y);
+SmokeSystem smoke_system_init(uint64_t seed);
+void create_particle(SmokeParticles* particles, int index, Rng* rng, float x, float y);
 void smoke_system_start(SmokeSystem* system, const Player* player);
-void smoke_system_update(SmokeSystem* system, float delta_time);
+void smoke_system_update(SmokeSystem* system, JobSystem* jobs, float delta_time);
 
 #endif
\ No newline at end of file
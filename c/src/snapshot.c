@@ -0,0 +1,104 @@
+#include "snapshot.h"
+#include <string.h>
+
+static void snapshot_wave(const WaveGenerator* wave, GameSnapshot* snapshot) {
+    memset(snapshot->wave_activated, 0, sizeof(snapshot->wave_activated));
+    for (int i = 0; i < GHOST_WIDTH; i++) {
+        snapshot->wave_y[i] = wave->points[i].y.value;
+        snapshot->wave_activated[i >> 3] |= (uint8_t)(wave->points[i].activated << (i & 7));
+    }
+    snapshot->wave_num_points = wave->num_points;
+    snapshot->wave_last_x = wave->last_x;
+    snapshot->wave_scroll_speed = wave->scroll_speed;
+    snapshot->wave_position_offset = wave->position_offset;
+    snapshot->ghost = wave->ghost;
+    snapshot->wave_rng = wave->rng;
+}
+
+static void restore_wave(WaveGenerator* wave, const GameSnapshot* snapshot) {
+    for (int i = 0; i < GHOST_WIDTH; i++) {
+        wave->points[i].x.value = i << F22_FRACTION_BITS;
+        wave->points[i].y.value = snapshot->wave_y[i];
+        wave->points[i].activated = (snapshot->wave_activated[i >> 3] >> (i & 7)) & 1;
+    }
+    wave->num_points = snapshot->wave_num_points;
+    wave->last_x = snapshot->wave_last_x;
+    wave->scroll_speed = snapshot->wave_scroll_speed;
+    wave->position_offset = snapshot->wave_position_offset;
+    wave->ghost = snapshot->ghost;
+    wave->rng = snapshot->wave_rng;
+}
+
+// explosion_start/smoke_system_start rebuild every particle, so the arrays of an
+// inactive system carry no state worth copying
+static void copy_explosion(ExplosionSystem* dst, const ExplosionSystem* src) {
+    if (src->active) {
+        *dst = *src;
+        return;
+    }
+    dst->active = false;
+    dst->time = src->time;
+    dst->origin_x = src->origin_x;
+    dst->origin_y = src->origin_y;
+    dst->rng = src->rng;
+}
+
+static void copy_smoke(SmokeSystem* dst, const SmokeSystem* src) {
+    if (src->active) {
+        *dst = *src;
+        return;
+    }
+    dst->active = false;
+    dst->time = src->time;
+    dst->origin_x = src->origin_x;
+    dst->origin_y = src->origin_y;
+    dst->rng = src->rng;
+}
+
+void game_state_snapshot(const GameState* state, GameSnapshot* snapshot) {
+    snapshot->state = state->state;
+    snapshot->camera_y_offset = state->camera_y_offset;
+    snapshot->target_y_offset = state->target_y_offset;
+    snapshot->player = state->player;
+    memcpy(snapshot->obstacles, state->obstacles, sizeof(snapshot->obstacles));
+    snapshot->last_obstacle_x = state->last_obstacle_x;
+    snapshot->score = state->score;
+    snapshot->scoring = state->scoring;
+
+    snapshot_wave(&state->wave, snapshot);
+
+    const AsteroidSystem* asteroids = &state->asteroid_system;
+    snapshot->num_asteroids = asteroid_system_save(asteroids, snapshot->asteroids);
+    snapshot->asteroid_spawn_timer = asteroids->spawn_timer;
+    snapshot->asteroid_particle_spawn_timer = asteroids->particle_spawn_timer;
+    snapshot->asteroid_last_particle_spawn = asteroids->last_particle_spawn;
+    snapshot->asteroid_active_particle_count = asteroids->active_particle_count;
+    snapshot->asteroid_rng = asteroids->rng;
+
+    copy_explosion(&snapshot->explosion, &state->explosion);
+    copy_smoke(&snapshot->smoke, &state->smoke_system);
+}
+
+void game_state_restore(GameState* state, const GameSnapshot* snapshot) {
+    state->state = snapshot->state;
+    state->camera_y_offset = snapshot->camera_y_offset;
+    state->target_y_offset = snapshot->target_y_offset;
+    state->player = snapshot->player;
+    memcpy(state->obstacles, snapshot->obstacles, sizeof(state->obstacles));
+    state->last_obstacle_x = snapshot->last_obstacle_x;
+    state->score = snapshot->score;
+    state->scoring = snapshot->scoring;
+
+    restore_wave(&state->wave, snapshot);
+
+    AsteroidSystem* asteroids = &state->asteroid_system;
+    asteroid_system_load(asteroids, snapshot->asteroids, snapshot->num_asteroids);
+    asteroids->spawn_timer = snapshot->asteroid_spawn_timer;
+    asteroids->particle_spawn_timer = snapshot->asteroid_particle_spawn_timer;
+    asteroids->last_particle_spawn = snapshot->asteroid_last_particle_spawn;
+    asteroids->active_particle_count = snapshot->asteroid_active_particle_count;
+    asteroids->rng = snapshot->asteroid_rng;
+
+    copy_explosion(&state->explosion, &snapshot->explosion);
+    copy_smoke(&state->smoke_system, &snapshot->smoke);
+}
@@ -0,0 +1,48 @@
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include "game_state.h"
+
+#define SNAPSHOT_WAVE_BITS_BYTES ((GHOST_WIDTH + 7) / 8)
+
+// Simulation-only copy of a GameState for rollouts, rewind and verification.
+// Resource handles (SoundSystem, Mix_Chunk pointers) are never captured, and
+// restoring leaves the target's sound system untouched.
+typedef struct {
+    GameStateEnum state;
+    F22 camera_y_offset;
+    F22 target_y_offset;
+    Player player;
+    Obstacle obstacles[MAX_OBSTACLES];
+    F22 last_obstacle_x;
+    uint32_t score;
+    ScoringSystem scoring;
+
+    // Wave point x always equals its index, so only y and the activation bits are kept
+    int32_t wave_y[GHOST_WIDTH];
+    uint8_t wave_activated[SNAPSHOT_WAVE_BITS_BYTES];
+    int wave_num_points;
+    F22 wave_last_x;
+    int wave_scroll_speed;
+    float wave_position_offset;
+    GhostPlayer ghost;
+    Rng wave_rng;
+
+    // Active asteroids only
+    AsteroidSnapshot asteroids[MAX_ASTEROIDS];
+    int num_asteroids;
+    float asteroid_spawn_timer;
+    float asteroid_particle_spawn_timer;
+    uint32_t asteroid_last_particle_spawn;
+    int asteroid_active_particle_count;
+    Rng asteroid_rng;
+
+    // Effects only run after a crash; while inactive just their rng/timers are copied
+    ExplosionSystem explosion;
+    SmokeSystem smoke;
+} GameSnapshot;
+
+void game_state_snapshot(const GameState* state, GameSnapshot* snapshot);
+void game_state_restore(GameState* state, const GameSnapshot* snapshot);
+
+#endif // SNAPSHOT_H
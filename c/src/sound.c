@@ -1,94 +1,494 @@
 // sound.c
 #include "sound.h"
 #include <SDL.h>
+#include <math.h>
+#include <string.h>
+#include "audio_probe.h"
+#include "pack.h"
+#include "pcm_cache.h"
 
-SoundSystem sound_system_create(void) {
+SoundSystem sound_system_create(uint64_t seed) {
     SoundSystem system = {0};
     system.initialized = false;
+    system.rng = rng_init(seed, RNG_STREAM_SOUND);
     return system;
 }
 
-static int pick_next_track(int current) {
+static int pick_next_track(Rng* rng, int current) {
     int next;
     do {
-        next = rand() % NUM_MUSIC_TRACKS;
+        next = rng_range(rng, NUM_MUSIC_TRACKS);
     } while(next == current && NUM_MUSIC_TRACKS > 1);
-    printf("NEXT: %d", next);
     return next;
 }
 
-static void play_random_track(SoundSystem* system) {
-    char path[100];
-    int next_track = pick_next_track(system->current_track);
-    
-    #ifdef __EMSCRIPTEN__
-    snprintf(path, sizeof(path), "/assets/sounds/music/%d.mp3", next_track);
-    #else  
-    snprintf(path, sizeof(path), "assets/sounds/music/%d.mp3", next_track);
-    #endif
+static MusicStreamer g_music;
+static EngineVoice g_engine;
+static AudioDevice g_device;
+static void* g_sounds[SOUND_COUNT];  // Mix_Chunk*, published by the loader
+
+static const struct {
+    const char* name;
+    const char* label;
+    int volume;
+} SOUND_FILES[SOUND_COUNT] = {
+    [SOUND_ENGINE] = { "sounds/engine.mp3", "engine", ENGINE_VOLUME },
+    [SOUND_COLLISION] = { "sounds/collision.mp3", "collision", COLLISION_VOLUME },
+    [SOUND_GAME_OVER] = { "sounds/game-over.mp3", "game over", GAME_OVER_VOLUME },
+};
+
+static const int AUDIO_BUFFER_FRAMES[] = {256, 512, 1024, 2048};
+#define AUDIO_BUFFER_STEPS (int)(sizeof(AUDIO_BUFFER_FRAMES) / sizeof(AUDIO_BUFFER_FRAMES[0]))
+
+static void audio_device_service(void);
 
-    // Free previous music if any
-    if (system->current_music) {
-        Mix_FreeMusic(system->current_music);
+static void music_track_name(int track, char* name, size_t size) {
+    if (track == MUSIC_STUB_TRACK) {
+        snprintf(name, size, "sounds/soundtrack.mp3");
+    } else {
+        snprintf(name, size, "sounds/music/%d.mp3", track);
     }
+}
 
-    system->current_music = Mix_LoadMUS(path);
-    if (!system->current_music) {
-        printf("Failed to load music track %d: %s\n", next_track, Mix_GetError());
-        return;
+static MusicTrack* music_load_track(int track) {
+    char name[PACK_NAME_SIZE];
+    music_track_name(track, name, sizeof(name));
+
+    // Decodes straight out of the asset pack; nothing is copied
+    SDL_RWops* rw = pack_open_rw(name);
+    if (!rw) {
+        printf("Failed to open music track %d: %s\n", track, SDL_GetError());
+        return NULL;
+    }
+    Mix_Music* music = Mix_LoadMUS_RW(rw, 1);
+    if (!music) {
+        printf("Failed to load music track %d: %s\n", track, Mix_GetError());
+        return NULL;
+    }
+
+    MusicTrack* loaded = SDL_malloc(sizeof(MusicTrack));
+    loaded->music = music;
+    loaded->track = track;
+    return loaded;
+}
+
+static void music_free_track(MusicTrack* track) {
+    if (!track) return;
+    Mix_FreeMusic(track->music);
+    SDL_free(track);
+}
+
+// Keeps one decoded-ready track waiting in g_music.ready
+static void music_prefetch(void) {
+    if (SDL_AtomicGetPtr(&g_music.ready)) return;
+
+    // Skip over tracks that fail to load instead of going silent
+    for (int attempt = 0; attempt < NUM_MUSIC_TRACKS; attempt++) {
+        if (g_music.wanted_track < 0) {
+            g_music.wanted_track = pick_next_track(&g_music.rng, g_music.last_track);
+        }
+        int next = g_music.wanted_track;
+
+        // Web: the track downloads in the background; try again next service
+        char name[PACK_NAME_SIZE];
+        music_track_name(next, name, sizeof(name));
+        PackStatus status = pack_status(name);
+        if (status == PACK_REMOTE || status == PACK_FETCHING) {
+            pack_fetch(name);
+            return;
+        }
+
+        g_music.wanted_track = -1;
+        g_music.last_track = next;
+        if (status != PACK_RESIDENT) continue;  // not shipped, or the download failed
+        MusicTrack* track = music_load_track(next);
+        if (track) {
+            SDL_AtomicSetPtr(&g_music.ready, track);
+            return;
+        }
+    }
+}
+
+static bool music_is_stub(const MusicTrack* track) {
+    return track && track->track == MUSIC_STUB_TRACK;
+}
+
+// The soundtrack stands in while the first real track downloads (web)
+static MusicTrack* music_load_stub(void) {
+    if (g_music.stub_failed) return NULL;
+
+    char name[PACK_NAME_SIZE];
+    music_track_name(MUSIC_STUB_TRACK, name, sizeof(name));
+    PackStatus status = pack_status(name);
+    if (status == PACK_REMOTE || status == PACK_FETCHING) {
+        pack_fetch(name);
+        return NULL;
+    }
+
+    MusicTrack* stub = status == PACK_RESIDENT ? music_load_track(MUSIC_STUB_TRACK) : NULL;
+    g_music.stub_failed = stub == NULL;
+    return stub;
+}
+
+static void music_play_next(int fade_ms) {
+    MusicTrack* next = SDL_AtomicSetPtr(&g_music.ready, NULL);
+    int loops = 1;  // real tracks play once
+    if (!next) {
+        if (music_is_stub(g_music.playing)) return;  // already looping
+
+        // Nothing downloaded yet: loop the stub, or stay silent until it arrives
+        next = music_load_stub();
+        loops = -1;
+        if (!next) {
+            music_free_track(g_music.playing);
+            g_music.playing = NULL;
+            return;
+        }
     }
-    printf("NOW PLAYING: %s", path);
 
     Mix_VolumeMusic(MUSIC_VOLUME);
-    Mix_PlayMusic(system->current_music, 1);  // play once
-    system->current_track = next_track;
+    if (Mix_FadeInMusic(next->music, loops, fade_ms) < 0) {
+        printf("Failed to play music track %d: %s\n", next->track, Mix_GetError());
+        music_free_track(next);
+        return;
+    }
+    // The previous track has already finished, so it is safe to free
+    music_free_track(g_music.playing);
+    g_music.playing = next;
+    g_music.fading_out = false;
+    if (music_is_stub(next)) {
+        printf("NOW PLAYING: soundtrack (waiting for music)\n");
+    } else {
+        printf("NOW PLAYING: %d\n", next->track);
+    }
+}
+
+// All Mix_*Music calls happen here, never on the audio thread
+static void music_service(void) {
+    if (!SDL_AtomicGet(&g_music.quit)) {
+        audio_device_service();
+    }
+    bool finished = SDL_AtomicSet(&g_music.finished, 0) != 0;
+
+    if (!SDL_AtomicGet(&g_music.enabled)) {
+        if (g_music.playing) {
+            Mix_HaltMusic();
+            music_free_track(g_music.playing);
+            g_music.playing = NULL;
+            SDL_AtomicSet(&g_music.finished, 0);  // the halt fires the hook too
+        }
+    } else if (!g_music.playing) {
+        music_play_next(0);
+    } else if (finished) {
+        music_play_next(MUSIC_CROSSFADE_MS);
+    } else if (g_music.fading_out) {
+        // Waiting for the fade to end; the finished hook picks it up
+    } else if (music_is_stub(g_music.playing)) {
+        // A real track has arrived: fade the stub out and hand over
+        if (SDL_AtomicGetPtr(&g_music.ready)) {
+            Mix_FadeOutMusic(MUSIC_CROSSFADE_MS);
+            g_music.fading_out = true;
+        }
+    } else {
+        // Fade the current track out over its last moments so the next one
+        // can fade in right behind it
+        #if SDL_MIXER_VERSION_ATLEAST(2, 6, 0)
+        double duration = Mix_MusicDuration(g_music.playing->music);
+        double position = Mix_GetMusicPosition(g_music.playing->music);
+        double remaining = duration - position;
+        if (duration > 0 && position >= 0 && remaining * 1000.0 <= MUSIC_CROSSFADE_MS) {
+            Mix_FadeOutMusic((int)(remaining * 1000.0));
+            g_music.fading_out = true;
+        }
+        #endif
+    }
+
+    if (!SDL_AtomicGet(&g_music.quit)) {
+        music_prefetch();
+    }
+}
+
+static int music_thread_main(void* arg) {
+    while (!SDL_AtomicGet(&g_music.quit)) {
+        SDL_SemWaitTimeout(g_music.wake, MUSIC_POLL_MS);
+        music_service();
+    }
+    return 0;
+}
+
+static void music_wake(void) {
+    if (g_music.wake) SDL_SemPost(g_music.wake);
 }
 
 static void music_finished_callback(void) {
-    if (g_sound_system) {
-        play_random_track(g_sound_system);
+    // Runs on the audio thread: no mixer calls, file I/O or allocation here
+    SDL_AtomicSet(&g_music.finished, 1);
+    music_wake();
+}
+
+#ifdef F22_SYNTH_ENGINE
+// Silent chunk kept looping on the engine channel so the mixer calls the
+// effect every buffer; the effect writes the synthesized engine over it
+static Uint8 g_engine_carrier[1024 * 4];
+
+static void engine_effect(int chan, void* stream, int len, void* udata) {
+    EngineVoice* voice = (EngineVoice*)udata;
+    Sint16* out = (Sint16*)stream;
+    int channels = voice->channels;
+    int frames = len / (int)(sizeof(Sint16) * channels);
+    bool thrust = SDL_AtomicGet(&voice->thrust) != 0;
+
+    float block[ENGINE_SYNTH_BLOCK];
+    for (int start = 0; start < frames; start += ENGINE_SYNTH_BLOCK) {
+        int count = frames - start < ENGINE_SYNTH_BLOCK ? frames - start : ENGINE_SYNTH_BLOCK;
+        engine_synth_render(&voice->synth, thrust, block, count);
+        for (int i = 0; i < count; i++) {
+            float sample = block[i] > 1.0f ? 1.0f : (block[i] < -1.0f ? -1.0f : block[i]);
+            for (int c = 0; c < channels; c++) {
+                out[(start + i) * channels + c] = (Sint16)(sample * 32767.0f);
+            }
+        }
     }
 }
+#else
+// Replaces the channel's output with the engine loop resampled at the
+// envelope's pitch and scaled by its gain. The mixer keeps the chunk looping
+// underneath, so the effect is called for every buffer.
+static void engine_effect(int chan, void* stream, int len, void* udata) {
+    EngineVoice* voice = (EngineVoice*)udata;
+    Sint16* out = (Sint16*)stream;
+    const Sint16* loop = (const Sint16*)voice->loop->abuf;
+    int channels = voice->channels;
+    int frames = len / (int)(sizeof(Sint16) * channels);
+    int loop_frames = (int)(voice->loop->alen / (sizeof(Sint16) * channels));
+    if (loop_frames < 2) return;
 
-void sound_system_init(SoundSystem* system) {
-    if (Mix_OpenAudio(44100, MIX_DEFAULT_FORMAT, 2, 2048) < 0) {
-        printf("SDL_mixer init failed: %s\n", Mix_GetError());
+    float target = SDL_AtomicGet(&voice->thrust) ? 1.0f : 0.0f;
+    float coeff = target > voice->gain ? voice->attack : voice->release;
+
+    // Fully released: keep the loop position moving but skip the work
+    if (target == 0.0f && voice->gain < 1e-4f) {
+        voice->gain = 0.0f;
+        voice->phase = fmod(voice->phase + frames * (double)ENGINE_IDLE_PITCH, loop_frames);
+        memset(stream, 0, (size_t)len);
         return;
     }
 
-    system->current_track = -1;
-    system->current_music = NULL;
-    
-    #ifdef __EMSCRIPTEN__
-    system->f22_engine = Mix_LoadWAV("/assets/sounds/engine.mp3");
-    system->collision = Mix_LoadWAV("/assets/sounds/collision.mp3");
-    system->game_over = Mix_LoadWAV("/assets/sounds/game-over.mp3");
-    #else
-    system->f22_engine = Mix_LoadWAV("assets/sounds/engine.mp3");
-    system->collision = Mix_LoadWAV("assets/sounds/collision.mp3");
-    system->game_over = Mix_LoadWAV("/assets/sounds/game-over.mp3");
-    #endif
+    for (int i = 0; i < frames; i++) {
+        voice->gain += (target - voice->gain) * coeff;
+
+        int i0 = (int)voice->phase;
+        int i1 = i0 + 1 < loop_frames ? i0 + 1 : 0;
+        float frac = (float)(voice->phase - i0);
+        for (int c = 0; c < channels; c++) {
+            float a = loop[i0 * channels + c];
+            float b = loop[i1 * channels + c];
+            out[i * channels + c] = (Sint16)((a + (b - a) * frac) * voice->gain);
+        }
+
+        voice->phase += ENGINE_IDLE_PITCH + (1.0f - ENGINE_IDLE_PITCH) * voice->gain;
+        if (voice->phase >= loop_frames) voice->phase -= loop_frames;
+    }
+}
+#endif
+
+static float engine_coefficient(int ms, int frequency) {
+    return 1.0f - expf(-1000.0f / ((float)ms * (float)frequency));
+}
 
-    if (!system->f22_engine) {
-        printf("Failed to load engine sound: %s\n", Mix_GetError());
+static bool engine_voice_attach(void) {
+    if (Mix_PlayChannel(ENGINE_CHANNEL, g_engine.loop, -1) < 0 ||
+        !Mix_RegisterEffect(ENGINE_CHANNEL, engine_effect, NULL, &g_engine)) {
+        printf("Failed to start engine loop: %s\n", Mix_GetError());
+        Mix_HaltChannel(ENGINE_CHANNEL);
+        return false;
     }
-    if (!system->collision) {
-        printf("Failed to load collision sound: %s\n", Mix_GetError());
+    return true;
+}
+
+// Loader thread, with the device lock held. Thrust may already be on; the
+// envelope picks it up from the first buffer.
+static void engine_voice_start(Mix_Chunk* engine) {
+    int frequency, channels;
+    Uint16 format;
+    if (!Mix_QuerySpec(&frequency, &format, &channels)) return;
+    if (format != AUDIO_S16SYS) {
+        printf("Engine envelope needs 16-bit output, falling back to start/stop\n");
+        return;
+    }
+
+    g_engine.loop = engine;
+    g_engine.channels = channels;
+    g_engine.attack = engine_coefficient(ENGINE_ATTACK_MS, frequency);
+    g_engine.release = engine_coefficient(ENGINE_RELEASE_MS, frequency);
+    g_engine.gain = 0.0f;
+    g_engine.phase = 0.0;
+    #ifdef F22_SYNTH_ENGINE
+    engine_synth_init(&g_engine.synth, frequency);
+    #endif
+
+    if (engine_voice_attach()) {
+        SDL_AtomicSet(&g_engine.installed, 1);
+    } else {
+        g_engine.loop = NULL;
     }
-    if (!system->game_over) {
-        printf("Failed to load game over sound: %s\n", Mix_GetError());
+}
+
+static Mix_Chunk* sound_chunk(SoundId id) {
+    return (Mix_Chunk*)SDL_AtomicGetPtr(&g_sounds[id]);
+}
+
+// Output format the effects are converted to, 0 while the device is closed.
+// Only changes under g_device.lock.
+static uint64_t audio_device_format(void) {
+    int frequency, channels;
+    Uint16 format;
+    if (!Mix_QuerySpec(&frequency, &format, &channels)) return 0;
+    return (uint64_t)frequency << 24 | (uint64_t)format << 8 | (uint64_t)channels;
+}
+
+static void sound_load_task(void* arg) {
+    SoundId id = (SoundId)(intptr_t)arg;
+
+    // Decoding is too slow to hold the device lock for, so a buffer-size
+    // reopen in audio_device_service can land in the middle; decode again
+    // if the device format changed before the chunk is published
+    for (int attempt = 0; attempt < AUDIO_BUFFER_STEPS; attempt++) {
+        SDL_LockMutex(g_device.lock);
+        uint64_t format = audio_device_format();
+        SDL_UnlockMutex(g_device.lock);
+
+        Mix_Chunk* chunk = pcm_cache_load(SOUND_FILES[id].name);
+        SDL_LockMutex(g_device.lock);
+        if (audio_device_format() != format) {
+            SDL_UnlockMutex(g_device.lock);
+            pcm_cache_free(chunk);
+            continue;
+        }
+        if (chunk) {
+            Mix_VolumeChunk(chunk, SOUND_FILES[id].volume);
+            if (id == SOUND_ENGINE) engine_voice_start(chunk);
+            SDL_AtomicSetPtr(&g_sounds[id], chunk);
+        }
+        SDL_UnlockMutex(g_device.lock);
+
+        if (!chunk) printf("Failed to load %s sound: %s\n", SOUND_FILES[id].label, Mix_GetError());
+        return;
     }
+    printf("Audio device kept reopening, %s sound skipped\n", SOUND_FILES[id].label);
+}
 
-    if (system->f22_engine) Mix_VolumeChunk(system->f22_engine, ENGINE_VOLUME);
-    if (system->collision) Mix_VolumeChunk(system->collision, COLLISION_VOLUME);
-    if (system->game_over) Mix_VolumeChunk(system->game_over, GAME_OVER_VOLUME);
+static bool audio_device_open(int index) {
+    if (Mix_OpenAudio(AUDIO_FREQUENCY, MIX_DEFAULT_FORMAT, 2, AUDIO_BUFFER_FRAMES[index]) < 0) {
+        return false;
+    }
+    int frequency, channels;
+    Uint16 format;
+    Mix_QuerySpec(&frequency, &format, &channels);
 
-    // Set up music finished callback
     Mix_HookMusicFinished(music_finished_callback);
-    
-    system->initialized = true;
-    system->engine_channel = 0;
     Mix_ReserveChannels(1);
+    audio_probe_install(ENGINE_CHANNEL, frequency, format, channels);
+    g_device.buffer_index = index;
+    g_device.open = true;
+    return true;
+}
+
+static void audio_device_close(void) {
+    audio_probe_remove(ENGINE_CHANNEL);
+    Mix_CloseAudio();
+    g_device.open = false;
+}
+
+// Steps the buffer up after repeated underruns. Reopening stops every channel
+// and the music, so the engine loop and the current track are restarted from
+// where they were.
+static void audio_device_service(void) {
+    if (!g_device.open || g_device.buffer_index + 1 >= AUDIO_BUFFER_STEPS) return;
+    if (audio_probe_underruns() < AUDIO_BACKOFF_UNDERRUNS) return;
+
+    int previous = g_device.buffer_index;
+    printf("Audio: %u underruns with %d-frame buffers, trying %d\n",
+           audio_probe_underruns(), AUDIO_BUFFER_FRAMES[previous],
+           AUDIO_BUFFER_FRAMES[previous + 1]);
+
+    double position = -1.0;
+    #if SDL_MIXER_VERSION_ATLEAST(2, 6, 0)
+    if (g_music.playing) position = Mix_GetMusicPosition(g_music.playing->music);
+    #endif
+
+    SDL_LockMutex(g_device.lock);
+    Mix_HaltMusic();
+    audio_device_close();
+    if (!audio_device_open(previous + 1) && !audio_device_open(previous)) {
+        printf("Failed to reopen audio: %s\n", Mix_GetError());
+    }
+    if (g_device.open && SDL_AtomicGet(&g_engine.installed)) {
+        engine_voice_attach();
+    }
+    SDL_UnlockMutex(g_device.lock);
+    SDL_AtomicSet(&g_music.finished, 0);  // the halt fires the hook
+
+    if (g_device.open && g_music.playing) {
+        Mix_VolumeMusic(MUSIC_VOLUME);
+        Mix_PlayMusic(g_music.playing->music, music_is_stub(g_music.playing) ? -1 : 1);
+        if (position > 0) Mix_SetMusicPosition(position);
+        g_music.fading_out = false;
+    }
+}
+
+void sound_system_init(SoundSystem* system, Loader* loader) {
+    // Smallest buffer first; audio_device_service backs off from there
+    for (int i = 0; i < AUDIO_BUFFER_STEPS && !g_device.open; i++) {
+        audio_device_open(i);
+    }
+    if (!g_device.open) {
+        printf("SDL_mixer init failed: %s\n", Mix_GetError());
+        return;
+    }
+    g_device.lock = SDL_CreateMutex();
+
+    #ifdef F22_SYNTH_ENGINE
+    // Nothing to decode for the engine; it is generated in the effect
+    Mix_Chunk* carrier = Mix_QuickLoad_RAW(g_engine_carrier, sizeof(g_engine_carrier));
+    if (carrier) {
+        Mix_VolumeChunk(carrier, ENGINE_VOLUME);
+        engine_voice_start(carrier);
+        SDL_AtomicSetPtr(&g_sounds[SOUND_ENGINE], carrier);
+    }
+    int first_sound = SOUND_ENGINE + 1;
+    #else
+    int first_sound = SOUND_ENGINE;
+    #endif
+
+    // Decoding the MP3s to PCM is the slow part (and skipped entirely when
+    // the PCM cache hits); the game runs without them
+    for (int i = first_sound; i < SOUND_COUNT; i++) {
+        loader_add(loader, SOUND_FILES[i].name, sound_load_task, (void*)(intptr_t)i);
+    }
+
+    system->initialized = true;
+    system->engine_channel = ENGINE_CHANNEL;
+
+    // Music gets its own copy of the stream; the thread owns it from here
+    g_music.rng = system->rng;
+    g_music.last_track = -1;
+    g_music.wanted_track = -1;
+    pack_fetch("sounds/soundtrack.mp3");  // web: start downloading the stand-in early
+    #if !defined(__EMSCRIPTEN__) || defined(__EMSCRIPTEN_PTHREADS__)
+    g_music.wake = SDL_CreateSemaphore(0);
+    g_music.thread = SDL_CreateThread(music_thread_main, "f22_music", NULL);
+    if (!g_music.thread) {
+        printf("Failed to start music thread: %s\n", SDL_GetError());
+    }
+    #endif
+    music_wake();  // prefetch the first track while the menu is up
+}
+
+void sound_system_update(void) {
+    if (!g_music.thread) {
+        music_service();
+    }
 }
 
 SoundSystem* get_sound_system() {
@@ -100,7 +500,8 @@ void set_sound_system(SoundSystem* system) {
 }
 
 void play_random() {
-    play_random_track(g_sound_system);
+    SDL_AtomicSet(&g_music.enabled, 1);
+    music_wake();
 }
 
 // void sound_system_init(SoundSystem* system) {
@@ -132,59 +533,109 @@ void play_random() {
 // }
 
 void sound_system_cleanup(SoundSystem* system) {
-    // first stop and free the music
+    if (!system->initialized) return;   // the mixer never opened
+
+    // first stop the music thread and free the music
     sound_system_stop_music(system);
-    
-    // then free sound effects
-    if (system->f22_engine) {
-        Mix_FreeChunk(system->f22_engine);
-        system->f22_engine = NULL;
+    SDL_AtomicSet(&g_music.quit, 1);
+    if (g_music.thread) {
+        music_wake();
+        SDL_WaitThread(g_music.thread, NULL);
+        g_music.thread = NULL;
+    }
+    music_service();
+    music_free_track(SDL_AtomicSetPtr(&g_music.ready, NULL));
+    if (g_music.wake) {
+        SDL_DestroySemaphore(g_music.wake);
+        g_music.wake = NULL;
     }
-    if (system->collision) {
-        Mix_FreeChunk(system->collision);
-        system->collision = NULL;
+    
+    // then free sound effects, once the effect can no longer read the engine
+    if (SDL_AtomicGet(&g_engine.installed)) {
+        Mix_UnregisterEffect(system->engine_channel, engine_effect);
+        Mix_HaltChannel(system->engine_channel);
+        SDL_AtomicSet(&g_engine.installed, 0);
+        g_engine.loop = NULL;
     }
-    if (system->game_over) {
-        Mix_FreeChunk(system->game_over);
-        system->game_over = NULL;
+    for (int i = 0; i < SOUND_COUNT; i++) {
+        Mix_Chunk* chunk = SDL_AtomicSetPtr(&g_sounds[i], NULL);
+        pcm_cache_free(chunk);
     }
     
     // finally close audio system
-    Mix_CloseAudio();
+    if (g_device.open) {
+        sound_system_report();
+        audio_device_close();
+    }
+    SDL_DestroyMutex(g_device.lock);
+    g_device.lock = NULL;
     system->initialized = false;
 }
 
-void sound_system_stop_music(SoundSystem* system) {
-    if (system->current_music) {
-        Mix_HaltMusic();  // stop any playing music
-        Mix_FreeMusic(system->current_music);  // free the music data
-        system->current_music = NULL;
-        system->current_track = -1;
+void sound_system_report(void) {
+    SDL_LockMutex(g_device.lock);
+    if (g_device.open) {
+        AudioStats stats;
+        audio_probe_stats(&stats);
+        printf("Audio: %d Hz, %d-frame buffer (%.1f ms), latency %.1f ms, "
+               "mix avg %.2f ms / max %.2f ms, %u underruns in %u callbacks\n",
+               stats.frequency, stats.buffer_frames, stats.buffer_ms, stats.latency_ms,
+               stats.mix_avg_ms, stats.mix_max_ms, stats.underruns, stats.callbacks);
     }
+    SDL_UnlockMutex(g_device.lock);
+}
+
+void sound_system_stop_music(SoundSystem* system) {
+    // The music thread halts and frees the current track
+    SDL_AtomicSet(&g_music.enabled, 0);
+    music_wake();
+}
+
+void sound_system_set_engine_climb(SoundSystem* system, float climb) {
+    #ifdef F22_SYNTH_ENGINE
+    engine_synth_set_climb(&g_engine.synth, climb);
+    #endif
 }
 
 void sound_system_start_engine(SoundSystem* system) {
-    if (!system->engine_playing && system->f22_engine) {
-        system->engine_playing = true;
-        Mix_PlayChannel(system->engine_channel, system->f22_engine, -1);
+    if (system->engine_playing) return;
+    system->engine_playing = true;
+    SDL_AtomicSet(&g_engine.thrust, 1);  // heard as soon as the loop is installed
+
+    // Fallback without the envelope; the chunk is published after the
+    // envelope is installed, so seeing it settles which path applies
+    Mix_Chunk* engine = sound_chunk(SOUND_ENGINE);
+    if (engine && !SDL_AtomicGet(&g_engine.installed)) {
+        SDL_LockMutex(g_device.lock);
+        Mix_PlayChannel(system->engine_channel, engine, -1);
+        SDL_UnlockMutex(g_device.lock);
     }
 }
 
 void sound_system_stop_engine(SoundSystem* system) {
-    if (system->engine_playing) {
+    if (!system->engine_playing) return;
+    system->engine_playing = false;
+    SDL_AtomicSet(&g_engine.thrust, 0);
+
+    if (sound_chunk(SOUND_ENGINE) && !SDL_AtomicGet(&g_engine.installed)) {
+        SDL_LockMutex(g_device.lock);
         Mix_HaltChannel(system->engine_channel);
-        system->engine_playing = false;
+        SDL_UnlockMutex(g_device.lock);
     }
 }
 
+static void sound_play_once(SoundId id) {
+    Mix_Chunk* chunk = sound_chunk(id);
+    if (!chunk) return;  // still decoding
+    SDL_LockMutex(g_device.lock);
+    Mix_PlayChannel(-1, chunk, 0);  // play once on any free channel
+    SDL_UnlockMutex(g_device.lock);
+}
+
 void sound_system_play_collision(SoundSystem* system) {
-    if (system->collision) {
-        Mix_PlayChannel(-1, system->collision, 0);  // play once on any free channel
-    }
+    sound_play_once(SOUND_COLLISION);
 }
 
 void sound_system_play_game_over(SoundSystem* system) {
-    if (system->game_over) {
-        Mix_PlayChannel(-1, system->game_over, 0);
-    }
-}
\ No newline at end of file
+    sound_play_once(SOUND_GAME_OVER);
+}
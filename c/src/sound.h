@@ -4,23 +4,89 @@
 
 #include <SDL_mixer.h>
 #include <stdbool.h>
+#include "rng.h"
+#include "loader.h"
+#include "engine_synth.h"
 
 #define NUM_MUSIC_TRACKS 8
 #define ENGINE_VOLUME 50     // 25% volume (0-128 range)
 #define COLLISION_VOLUME 75  // 75% volume
 #define MUSIC_VOLUME 32      // 25% volume
 #define GAME_OVER_VOLUME 50
+#define MUSIC_CROSSFADE_MS 1500  // fade between consecutive tracks
+#define MUSIC_POLL_MS 100        // how often the music thread checks the fade point
+#define MUSIC_STUB_TRACK -2      // soundtrack.mp3, looped until a real track is ready
+#define AUDIO_FREQUENCY 44100
+#define AUDIO_BACKOFF_UNDERRUNS 3  // underruns tolerated at one buffer size
+#define ENGINE_CHANNEL 0         // reserved for the engine loop
+#define ENGINE_ATTACK_MS 15      // engine gain rise when thrust starts
+#define ENGINE_RELEASE_MS 60     // and fall when it stops
+#define ENGINE_IDLE_PITCH 0.85f  // playback rate at the bottom of the envelope
+
+// A music track opened over its asset pack entry, so the decoder reads from
+// memory and never touches the disk
+typedef struct {
+    Mix_Music* music;
+    int track;
+} MusicTrack;
+
+// Music is loaded and switched on its own thread (or from sound_system_update
+// when there are no threads). The mixer's finished hook only raises a flag.
+typedef struct {
+    SDL_Thread* thread;
+    SDL_sem* wake;
+    SDL_atomic_t quit;
+    SDL_atomic_t enabled;      // the game wants music playing
+    SDL_atomic_t finished;     // set from the audio thread when a track ends
+    void* ready;               // prefetched MusicTrack*, swapped atomically
+    MusicTrack* playing;       // music thread only; may be the looping stub
+    bool fading_out;
+    int last_track;
+    int wanted_track;          // picked but still downloading (web), or -1
+    bool stub_failed;          // the soundtrack stand-in is unavailable
+    Rng rng;
+} MusicStreamer;
+
+// The engine loop never stops; thrust only moves the target of a gain/pitch
+// envelope that a mixer effect applies on the audio thread. Toggling thrust is
+// a single atomic store, so taps neither restart the sample nor take the
+// mixer lock.
+typedef struct {
+    SDL_atomic_t thrust;       // set from the game, read once per audio buffer
+    SDL_atomic_t installed;    // the effect is running; otherwise plain play/halt
+    Mix_Chunk* loop;
+    int channels;
+    float attack;              // per-frame smoothing coefficients
+    float release;
+    float gain;                // audio thread only
+    double phase;              // read position in loop frames, audio thread only
+    EngineSynth synth;         // F22_SYNTH_ENGINE builds: generated instead of the loop
+} EngineVoice;
+
+// Output device. The buffer starts at the smallest size and grows a step each
+// time the probe (audio_probe.h) reports repeated underruns. The reopen runs
+// on the music thread, which owns the music that has to be restarted.
+typedef struct {
+    SDL_mutex* lock;           // held around channel playback so a reopen can't race it
+    int buffer_index;
+    bool open;
+} AudioDevice;
+
+// Sound effects, decoded on the loader thread. Each one is published in
+// sound.c as soon as it is ready and is silently skipped until then.
+typedef enum {
+    SOUND_ENGINE,              // engine loop
+    SOUND_COLLISION,           // crash sound
+    SOUND_GAME_OVER,
+    SOUND_COUNT
+} SoundId;
 
 typedef struct {
-    Mix_Music* current_music;
     Mix_Music* soundtrack;     // background music
-    Mix_Chunk* f22_engine;     // engine loop
-    Mix_Chunk* collision;      // crash sound
-    Mix_Chunk* game_over;
     bool engine_playing;      // track if engine sound is currently playing
     int engine_channel;       // keep track of which channel plays engine
     bool initialized;
-    int current_track;
+    Rng rng;                  // track selection, independent of gameplay
 } SoundSystem;
 
 static SoundSystem* g_sound_system = NULL;
@@ -28,19 +94,25 @@ static SoundSystem* g_sound_system = NULL;
 static void music_finished_callback(void);
 
 // init with reasonable defaults
-SoundSystem sound_system_create(void);
-void sound_system_init(SoundSystem* system);
+SoundSystem sound_system_create(uint64_t seed);
+// Opens the device and queues the sound effects on the loader
+void sound_system_init(SoundSystem* system, Loader* loader);
 
 // main functions you'll need
 void sound_system_cleanup(SoundSystem* system);
+// Prints the mixer telemetry (buffer, latency, mix time, underruns); also
+// printed by sound_system_cleanup
+void sound_system_report(void);
 void sound_system_stop_music(SoundSystem* system);
 void sound_system_start_engine(SoundSystem* system);
 void sound_system_stop_engine(SoundSystem* system);
+void sound_system_set_engine_climb(SoundSystem* system, float climb);  // -1 dive .. 1 climb
 void sound_system_play_collision(SoundSystem* system);
 void sound_system_play_game_over(SoundSystem* system);
 
 SoundSystem* get_sound_system();
 void set_sound_system(SoundSystem* system);
 void play_random();
+void sound_system_update(void);  // services music when it has no thread of its own
 
 #endif
\ No newline at end of file
@@ -0,0 +1,31 @@
+#include "ui_state.h"
+
+#ifdef __EMSCRIPTEN__
+#include <emscripten.h>
+#endif
+
+static UiState g_ui;
+
+void ui_state_publish(const RenderFrame* frame) {
+    UiState next = {
+        .version = g_ui.version,
+        .state = (int32_t)frame->state,
+        .score = frame->score,
+        .precision = frame->precision,
+        .missiles = 0,
+        .game_over = frame->game_over,
+    };
+    if (next.state != g_ui.state || next.score != g_ui.score ||
+        next.precision != g_ui.precision || next.game_over != g_ui.game_over) {
+        next.version++;
+    }
+    g_ui = next;
+}
+
+// Called once by the page at startup; the address never changes
+#ifdef __EMSCRIPTEN__
+EMSCRIPTEN_KEEPALIVE
+#endif
+const UiState* f22_ui_state(void) {
+    return &g_ui;
+}
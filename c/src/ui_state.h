@@ -0,0 +1,24 @@
+#ifndef UI_STATE_H
+#define UI_STATE_H
+
+#include <stdint.h>
+#include "frame.h"
+
+// What the page overlay (template.html) shows, kept at a fixed address in
+// linear memory. The main loop rewrites it once per rendered frame and the
+// page reads it once per requestAnimationFrame, so the game loop never calls
+// into JS. Every field is 4 bytes and the page indexes them as HEAP32/HEAPF32
+// words in this order; keep the two in sync.
+typedef struct {
+    uint32_t version;     // bumped by every publish that changed something
+    int32_t state;        // GameStateEnum
+    float score;
+    float precision;      // -1 (far off the wave) .. 1 (on it)
+    int32_t missiles;     // missiles left; 0 while the missile system is disabled
+    int32_t game_over;    // explosion finished, score is final
+} UiState;
+
+void ui_state_publish(const RenderFrame* frame);
+const UiState* f22_ui_state(void);   // exported to the page
+
+#endif // UI_STATE_H
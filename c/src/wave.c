@@ -43,7 +43,8 @@
 
 //     return wave;
 // }
-WaveGenerator wave_init(void) {
+WaveGenerator wave_init(uint64_t seed) {
+    Rng rng = rng_init(seed, RNG_STREAM_WAVE);
     WaveGenerator wave = {
         .num_points = GHOST_WIDTH,
         .last_x = f22_from_float(0.0f),
@@ -55,12 +56,15 @@ WaveGenerator wave_init(void) {
             .velocity_y = f22_from_float(0.0f),
             .should_thrust = false,
             .optimal_height = WINDOW_HEIGHT / 2,
-            .current_duration = 0.5f + ((float)rand() / (float)RAND_MAX) * 1.0f,
+            .current_duration = 0.5f + rng_float(&rng) * 1.0f,
             .is_rest_phase = false,
             .elapsed_time = 0.0f,
-            .phase_start_time = SDL_GetTicks() / 1000.0f
-        }
+            .phase_start_time = 0.0f
+        },
+        .rng = rng
     };
+    // Start "expired" so the first PLAYING tick picks a phase from the player's height
+    wave.ghost.elapsed_time = wave.ghost.current_duration;
 
     for (int i = 0; i < GHOST_WIDTH; i++) {
         wave.points[i].x = f22_from_float(i);
@@ -70,15 +74,13 @@ WaveGenerator wave_init(void) {
     return wave;
 }
 
-void wave_update_ghost(GhostPlayer* ghost, int player_y, float delta_time) {
-    // Simple pattern: thrust for 30 frames, then rest for 30 frames
-    float current_time = SDL_GetTicks() / 1000.0f;
-    float diff = current_time - ghost->phase_start_time;
+void wave_update_ghost(GhostPlayer* ghost, Rng* rng, int player_y, float delta_time) {
+    // Simple pattern: thrust for 30 frames, then rest for 30 frames.
+    // Phases are timed in simulation time so snapshots replay deterministically.
+    ghost->elapsed_time += delta_time;
+    float diff = ghost->elapsed_time;
     if (diff >= ghost->current_duration) {
-        ghost->phase_start_time = current_time;
-
-        printf("SWITCHING FROM %f WITH CURRENT TIME %f WITH DIFF %f", f22_to_float(ghost->y), ghost->current_duration, diff);
-        printf("CURRENT GHOST Y %f", f22_to_float(ghost->y));
+        ghost->phase_start_time += diff;
         ghost->elapsed_time = 0.0f;
         if ((int)f22_to_float(ghost->y) <= player_y) {
             ghost->is_rest_phase = true;
@@ -88,9 +90,9 @@ void wave_update_ghost(GhostPlayer* ghost, int player_y, float delta_time) {
         // ghost->is_rest_phase = !ghost->is_rest_phase;
 
         if (ghost->is_rest_phase) {
-            ghost->current_duration = ((float)rand() / (float)RAND_MAX) * 1.5f;
+            ghost->current_duration = rng_float(rng) * 1.5f;
         } else {
-            ghost->current_duration = ((float)rand() / (float)RAND_MAX) * 1.5f;
+            ghost->current_duration = rng_float(rng) * 1.5f;
         }
     }
 
@@ -249,7 +251,7 @@ void wave_update(WaveGenerator* wave, int player_y, GameStateEnum state, float d
     }
 
     if (state == GAME_STATE_PLAYING) {
-        wave_update_ghost(&wave->ghost, player_y, delta_time);
+        wave_update_ghost(&wave->ghost, &wave->rng, player_y, delta_time);
     } else {
         wave->ghost.y = f22_from_float(WINDOW_HEIGHT / 2);
         return;
@@ -263,21 +265,11 @@ void wave_update(WaveGenerator* wave, int player_y, GameStateEnum state, float d
     //     wave->points[i].x = f22_from_float(i);
     //     wave->points[i].y = wave->points[i + 1].y;
     // }
-    // Shift existing points left
-    int iterations = (int) GHOST_WIDTH / (int) shift;
-    int i = 0;
-    while (i < iterations)
-    {
-        int k = 0;
-        while (k < (int) shift)
-        {
-            int index = i * (int) shift + k;
-            wave->points[index].x = f22_from_float(index);
-            wave->points[index].y = wave->points[index+(int)shift].y;
-            wave->points[index].activated = wave->points[index+(int)shift].activated;
-            k++;
-        }
-        i++;
+    // Shift existing points left. x always equals the point index, so only
+    // y and the activation flag move (this runs every tick for every game).
+    for (int i = 0; i < GHOST_WIDTH - shift; i++) {
+        wave->points[i].y = wave->points[i + shift].y;
+        wave->points[i].activated = wave->points[i + shift].activated;
     }
 
     int index = GHOST_WIDTH - shift;
@@ -298,3 +290,105 @@ void wave_update(WaveGenerator* wave, int player_y, GameStateEnum state, float d
     // wave->points[GHOST_WIDTH - 1].x = f22_from_float(GHOST_WIDTH - 1);
     // wave->points[GHOST_WIDTH - 1].y = wave->ghost.y;
 }
+
+#define WAVE_RIPPLE_SPEED 2.0f
+#define WAVE_RIPPLE_AMPLITUDE 25.0f
+#define WAVE_RIPPLE_FREQUENCY 0.06f   // radians per column
+
+static void wave_build_vertex(const WavePoint* wave, int i, F22 camera_y_offset,
+                              ScreenPos player_pos, float time, SDL_Point* out) {
+    ScreenPos base_pos = world_to_screen(wave[i].x, wave[i].y, camera_y_offset);
+
+    // Calculate distance from this point to player
+    float dx = base_pos.x - player_pos.x;
+    float dy = base_pos.y - player_pos.y;
+    float dist = sqrtf(dx * dx + dy * dy);
+
+    // Smoothly fade the amplitude based on distance
+    float amplitude_factor = 1.0f;
+    if (dist > WAVE_EFFECT_RADIUS - WAVE_TRANSITION_RADIUS) {
+        amplitude_factor = fmaxf(0.0f,
+            1.0f - (dist - (WAVE_EFFECT_RADIUS - WAVE_TRANSITION_RADIUS)) / WAVE_TRANSITION_RADIUS);
+    }
+
+    float phase = i * WAVE_RIPPLE_FREQUENCY + time * WAVE_RIPPLE_SPEED;
+    float x_offset = WAVE_RIPPLE_AMPLITUDE * amplitude_factor * sin(phase);
+    float y_offset = WAVE_RIPPLE_AMPLITUDE * amplitude_factor * cos(phase);
+
+    out[i].x = base_pos.x + (int)x_offset;
+    out[i].y = base_pos.y + (int)y_offset;
+}
+
+#ifdef __wasm_simd128__
+// Four columns per iteration. The ripple phase advances by a fixed angle per
+// column, so sin/cos come from rotating the first four lanes instead of trig
+// calls; positions can differ from the scalar path by a pixel.
+static int wave_build_vertices_x4(const WavePoint* wave, int begin, int end, F22 camera_y_offset,
+                                  ScreenPos player_pos, float time, SDL_Point* out) {
+    float sin_lane[4], cos_lane[4];
+    for (int lane = 0; lane < 4; lane++) {
+        float phase = (begin + lane) * WAVE_RIPPLE_FREQUENCY + time * WAVE_RIPPLE_SPEED;
+        sin_lane[lane] = sinf(phase);
+        cos_lane[lane] = cosf(phase);
+    }
+    v128_t sin_phase = wasm_v128_load(sin_lane);
+    v128_t cos_phase = wasm_v128_load(cos_lane);
+    v128_t sin_step = wasm_f32x4_splat(sinf(4 * WAVE_RIPPLE_FREQUENCY));
+    v128_t cos_step = wasm_f32x4_splat(cosf(4 * WAVE_RIPPLE_FREQUENCY));
+
+    v128_t camera = wasm_i32x4_splat(camera_y_offset.value);
+    v128_t scale = wasm_f32x4_splat(WORLD_TO_SCREEN_SCALE);
+    v128_t player_x = wasm_f32x4_splat((float)player_pos.x);
+    v128_t player_y = wasm_f32x4_splat((float)player_pos.y);
+    v128_t inner = wasm_f32x4_splat(WAVE_EFFECT_RADIUS - WAVE_TRANSITION_RADIUS);
+    v128_t transition = wasm_f32x4_splat(WAVE_TRANSITION_RADIUS);
+    v128_t amplitude = wasm_f32x4_splat(WAVE_RIPPLE_AMPLITUDE);
+    v128_t zero = wasm_f32x4_splat(0.0f);
+    v128_t one = wasm_f32x4_splat(1.0f);
+
+    int i = begin;
+    for (; i + 4 <= end; i += 4) {
+        const WavePoint* w = &wave[i];
+        v128_t world_x = wasm_i32x4_make(w[0].x.value, w[1].x.value, w[2].x.value, w[3].x.value);
+        v128_t world_y = wasm_i32x4_make(w[0].y.value, w[1].y.value, w[2].y.value, w[3].y.value);
+
+        // world_to_screen
+        v128_t base_x = wasm_i32x4_trunc_sat_f32x4(wasm_f32x4_mul(f22x4_to_float(world_x), scale));
+        v128_t base_y = wasm_i32x4_trunc_sat_f32x4(
+            wasm_f32x4_mul(f22x4_to_float(f22x4_sub(world_y, camera)), scale));
+
+        v128_t dx = wasm_f32x4_sub(wasm_f32x4_convert_i32x4(base_x), player_x);
+        v128_t dy = wasm_f32x4_sub(wasm_f32x4_convert_i32x4(base_y), player_y);
+        v128_t dist = wasm_f32x4_sqrt(wasm_f32x4_add(wasm_f32x4_mul(dx, dx), wasm_f32x4_mul(dy, dy)));
+
+        // Above 1 inside the inner radius, so clamping both ends replaces the branch
+        v128_t factor = wasm_f32x4_sub(one, wasm_f32x4_div(wasm_f32x4_sub(dist, inner), transition));
+        factor = wasm_f32x4_min(one, wasm_f32x4_max(zero, factor));
+        v128_t reach = wasm_f32x4_mul(amplitude, factor);
+
+        v128_t x = wasm_i32x4_add(base_x, wasm_i32x4_trunc_sat_f32x4(wasm_f32x4_mul(reach, sin_phase)));
+        v128_t y = wasm_i32x4_add(base_y, wasm_i32x4_trunc_sat_f32x4(wasm_f32x4_mul(reach, cos_phase)));
+
+        // Interleave into SDL_Points; inactive columns are written too
+        wasm_v128_store(&out[i], wasm_i32x4_shuffle(x, y, 0, 4, 1, 5));
+        wasm_v128_store(&out[i + 2], wasm_i32x4_shuffle(x, y, 2, 6, 3, 7));
+
+        v128_t next_sin = wasm_f32x4_add(wasm_f32x4_mul(sin_phase, cos_step), wasm_f32x4_mul(cos_phase, sin_step));
+        cos_phase = wasm_f32x4_sub(wasm_f32x4_mul(cos_phase, cos_step), wasm_f32x4_mul(sin_phase, sin_step));
+        sin_phase = next_sin;
+    }
+    return i;
+}
+#endif
+
+void wave_build_vertices(const WavePoint* wave, int begin, int end, F22 camera_y_offset,
+                         ScreenPos player_pos, float time, SDL_Point* out) {
+    int i = begin;
+    #ifdef __wasm_simd128__
+    i = wave_build_vertices_x4(wave, begin, end, camera_y_offset, player_pos, time, out);
+    #endif
+    for (; i < end; i++) {
+        if (!wave[i].activated) continue;
+        wave_build_vertex(wave, i, camera_y_offset, player_pos, time, out);
+    }
+}
@@ -7,6 +7,7 @@
 #include <math.h>
 #include "config.h"
 #include "player.h"
+#include "rng.h"
 
 #define MAX_CONTROL_POINTS 128
 #define SCREEN_HEIGHT 600
@@ -49,12 +50,23 @@ typedef struct {
     int scroll_speed;
     float position_offset;
     GhostPlayer ghost;
+    Rng rng;
 } WaveGenerator;
 
 // Function declarations only
-WaveGenerator wave_init(void);
+WaveGenerator wave_init(uint64_t seed);
 void wave_generate_next_point(WaveGenerator* wave);
 F22 wave_get_y_at_x(const WaveGenerator* wave, F22 x);
 void wave_update(WaveGenerator* wave, int player_y, GameStateEnum state, float delta_time);
 
+// The wave ripples within this distance of the player, fading out over the
+// outer TRANSITION_RADIUS
+#define WAVE_EFFECT_RADIUS 200.0f
+#define WAVE_TRANSITION_RADIUS 100.0f
+
+// Screen-space vertex of each activated column in [begin, end) of the visible
+// window, with the ripple applied. Other columns of out are left undefined.
+void wave_build_vertices(const WavePoint* wave, int begin, int end, F22 camera_y_offset,
+                         ScreenPos player_pos, float time, SDL_Point* out);
+
 #endif // WAVE_H
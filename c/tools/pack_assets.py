@@ -0,0 +1,86 @@
+#!/usr/bin/env python3
+"""Packs the assets directory into one indexed archive (assets.pak).
+
+Layout, all little-endian:
+    header  magic "F22P", u32 version, u32 entry count, u32 reserved
+    index   one 64-byte entry per file: char name[48], u32 offset, u32 size,
+            u32 flags, u32 reserved
+    data    file contents, each aligned to 16 bytes
+
+Entries matching --external keep their index entry but no data (flag 1);
+the runtime fetches those on demand (web build) from <url root>/<name>.
+--add NAME=PATH embeds a generated file (e.g. pre-decoded PCM) under NAME.
+"""
+import argparse
+import fnmatch
+import os
+import struct
+import sys
+
+MAGIC = b"F22P"
+VERSION = 1
+NAME_SIZE = 48
+HEADER = struct.Struct("<4sIII")
+ENTRY = struct.Struct("<%dsIIII" % NAME_SIZE)
+ALIGN = 16
+FLAG_EXTERNAL = 1
+
+
+def collect(root):
+    files = []
+    for dirpath, _, names in os.walk(root):
+        for name in names:
+            path = os.path.join(dirpath, name)
+            rel = os.path.relpath(path, root).replace(os.sep, "/")
+            files.append((rel, path))
+    return sorted(files)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("root", help="assets directory")
+    parser.add_argument("out", help="archive to write")
+    parser.add_argument("--external", action="append", default=[],
+                        help="glob of entries to index without embedding")
+    parser.add_argument("--add", action="append", default=[], metavar="NAME=PATH",
+                        help="extra file to embed under the given entry name")
+    args = parser.parse_args()
+
+    files = collect(args.root)
+    for extra in args.add:
+        name, sep, path = extra.partition("=")
+        if not sep or not name or not path:
+            sys.exit("--add expects NAME=PATH: " + extra)
+        files.append((name, path))
+    files.sort()
+    for rel, _ in files:
+        if len(rel.encode()) >= NAME_SIZE:
+            sys.exit("asset name too long for the pack index: " + rel)
+
+    offset = HEADER.size + ENTRY.size * len(files)
+    entries = []
+    blobs = []
+    for rel, path in files:
+        size = os.path.getsize(path)
+        if any(fnmatch.fnmatch(rel, pattern) for pattern in args.external):
+            entries.append((rel, 0, size, FLAG_EXTERNAL))
+            continue
+        offset = (offset + ALIGN - 1) // ALIGN * ALIGN
+        entries.append((rel, offset, size, 0))
+        blobs.append((offset, path))
+        offset += size
+
+    tmp = args.out + ".tmp"
+    with open(tmp, "wb") as out:
+        out.write(HEADER.pack(MAGIC, VERSION, len(entries), 0))
+        for rel, data_offset, size, flags in entries:
+            out.write(ENTRY.pack(rel.encode(), data_offset, size, flags, 0))
+        for data_offset, path in blobs:
+            out.write(b"\0" * (data_offset - out.tell()))
+            with open(path, "rb") as f:
+                out.write(f.read())
+    os.replace(tmp, args.out)
+
+
+if __name__ == "__main__":
+    main()
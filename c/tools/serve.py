@@ -0,0 +1,71 @@
+#!/usr/bin/env python3
+"""Serves a web build locally with the headers that make the page cross-origin isolated.
+
+Browsers only hand out SharedArrayBuffer (and so run f22_game_mt.js) on pages
+served with
+    Cross-Origin-Opener-Policy: same-origin
+    Cross-Origin-Embedder-Policy: credentialless | require-corp
+
+credentialless is the default because the page pulls its fonts and leaderboard
+avatars from other origins. Safari only accepts require-corp, which blocks
+cross-origin resources that do not opt in; pass --require-corp to test that.
+--no-isolation serves without the headers, to check the single-threaded fallback.
+
+    python3 tools/serve.py build          # then open http://localhost:8000/f22_game.html
+"""
+import argparse
+import functools
+import http.server
+import os
+
+
+class IsolatedHandler(http.server.SimpleHTTPRequestHandler):
+    extensions_map = {
+        **http.server.SimpleHTTPRequestHandler.extensions_map,
+        ".wasm": "application/wasm",
+        ".js": "text/javascript",
+        ".data": "application/octet-stream",
+    }
+
+    def __init__(self, *args, embedder_policy=None, **kwargs):
+        self.embedder_policy = embedder_policy
+        super().__init__(*args, **kwargs)
+
+    def end_headers(self):
+        if self.embedder_policy:
+            self.send_header("Cross-Origin-Opener-Policy", "same-origin")
+            self.send_header("Cross-Origin-Embedder-Policy", self.embedder_policy)
+            self.send_header("Cross-Origin-Resource-Policy", "same-origin")
+        # Rebuilds should show up on reload
+        self.send_header("Cache-Control", "no-store")
+        super().end_headers()
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("directory", nargs="?", default=".", help="build directory to serve")
+    parser.add_argument("--port", type=int, default=8000)
+    policy = parser.add_mutually_exclusive_group()
+    policy.add_argument("--require-corp", action="store_true",
+                        help="send COEP require-corp instead of credentialless")
+    policy.add_argument("--no-isolation", action="store_true",
+                        help="send no COOP/COEP headers")
+    args = parser.parse_args()
+
+    embedder_policy = None
+    if not args.no_isolation:
+        embedder_policy = "require-corp" if args.require_corp else "credentialless"
+
+    handler = functools.partial(IsolatedHandler, directory=os.path.abspath(args.directory),
+                                embedder_policy=embedder_policy)
+    server = http.server.ThreadingHTTPServer(("localhost", args.port), handler)
+    print("Serving %s on http://localhost:%d/ (COEP: %s)"
+          % (args.directory, args.port, embedder_policy or "none"))
+    try:
+        server.serve_forever()
+    except KeyboardInterrupt:
+        pass
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,51 @@
+#!/usr/bin/env python3
+"""Prints the download size of a web build, raw and gzipped.
+
+Covers every f22_game*.wasm / .js in the directory (the SIMD and pthreads
+variants too). With a second directory it prints both and the difference,
+e.g. the checked-in ASYNCIFY build against a fresh one:
+
+    python3 tools/size_report.py build-asyncify build
+"""
+import argparse
+import glob
+import gzip
+import os
+
+
+def sizes(directory):
+    result = {}
+    for path in sorted(glob.glob(os.path.join(directory, "f22_game*.wasm")) +
+                       glob.glob(os.path.join(directory, "f22_game*.js"))):
+        with open(path, "rb") as f:
+            data = f.read()
+        result[os.path.basename(path)] = (len(data), len(gzip.compress(data, 9)))
+    return result
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("directory", help="build directory")
+    parser.add_argument("other", nargs="?", help="second build directory to compare against the first")
+    args = parser.parse_args()
+
+    before = sizes(args.directory)
+    if not before:
+        parser.error("no f22_game*.wasm or .js in %s" % args.directory)
+    if not args.other:
+        for name, (raw, packed) in before.items():
+            print("%-24s %10d raw %10d gzip" % (name, raw, packed))
+        return
+
+    after = sizes(args.other)
+    print("%-24s %21s %21s %21s" % ("", args.directory, args.other, "change"))
+    for name in sorted(set(before) | set(after)):
+        old = before.get(name, (0, 0))
+        new = after.get(name, (0, 0))
+        print("%-24s %10d %10d %10d %10d %+10d %+10d"
+              % (name, old[0], old[1], new[0], new[1], new[0] - old[0], new[1] - old[1]))
+    print("%-24s %10s %10s %10s %10s %10s %10s" % ("", "raw", "gzip", "raw", "gzip", "raw", "gzip"))
+
+
+if __name__ == "__main__":
+    main()